@@ -0,0 +1,69 @@
+#ifndef POLYNOMIAL_REGRESSION_CSV_H
+#define POLYNOMIAL_REGRESSION_CSV_H
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "polynomial_regression.hpp"
+
+// Fitting over CSV or other delimited text, parsed in chunks on a separate thread. This header is not
+// included by polynomial_regression.hpp.
+
+namespace andviane {
+
+// Options of reading the delimited text.
+  struct CsvOptions {
+    // Character separating the fields of a row.
+    char delimiter = ',';
+
+    // Zero based fields holding X and Y. If x_column is negative, X enumerates the parsed rows 0, 1, 2 ...
+    int x_column = 0;
+    int y_column = 1;
+
+    // Lines to skip at the beginning, like the header.
+    size_t skip_lines = 0;
+
+    // Size of the buffer the text is read into. Lines longer than this are skipped.
+    size_t chunk_size = 1 << 20;
+
+    // The number of data points in a parsed block, and the number of blocks that may be parsed ahead of the fit.
+    size_t block_size = 4096;
+    size_t queue_blocks = 4;
+  };
+
+// Counts of rows read by polynomial_regression_csv.
+  struct CsvRows {
+    // Rows that were fitted.
+    size_t parsed = 0;
+
+    // Non empty rows where X or Y was missing or not a number.
+    size_t skipped = 0;
+  };
+
+// Perform polynomial regression over the delimited text read from the file until its end. One thread reads
+// the text in chunks and parses it into blocks of values (using std::from_chars, so the locale does not
+// matter), while the calling thread accumulates the blocks. The blocks pass through the bounded queue, so
+// the memory usage does not depend on the size of the file. Values are parsed as double. Rows that cannot
+// be parsed are skipped. Returns false if reading fails.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE>
+  bool polynomial_regression_csv(std::FILE *file, Polynomial<order, TYPE, PRECISION> &result,
+                                 const CsvOptions &options = CsvOptions(), CsvRows *rows = nullptr);
+
+// Perform polynomial regression over the delimited text file. Returns false if it cannot be opened or read.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE>
+  bool polynomial_regression_csv(const std::string &path, Polynomial<order, TYPE, PRECISION> &result,
+                                 const CsvOptions &options = CsvOptions(), CsvRows *rows = nullptr);
+
+#include "internal/CsvRegression.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_CSV_H
@@ -0,0 +1,97 @@
+#ifndef POLYNOMIAL_DYNAMIC_POLYNOMIAL_H
+#define POLYNOMIAL_DYNAMIC_POLYNOMIAL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "Polynomial.hpp"
+#include "internal/SmallBuffer.hpp"
+#include "internal/regression_kernels.hpp"
+
+namespace andviane {
+
+// Polynomial with the order defined at runtime. Up to inline_coefficients coefficients are stored
+// inside the object without heap allocation.
+  template<typename TYPE=double, typename PRECISION = TYPE>
+  class DynamicPolynomial {
+  public:
+    static constexpr size_t inline_coefficients = 16;
+
+    explicit DynamicPolynomial(int order = 0, int n = 0, bool valid = true);
+
+    // Copy the coefficients, residual and R^2 of the fixed order polynomial.
+    template<int p_order>
+    DynamicPolynomial(const Polynomial<p_order, TYPE, PRECISION> &polynomial);
+
+    // Change the order, set all coefficients to zero and forget the residual. Reuses the storage if it is large enough.
+    void reset(int order, int n = 0, bool valid = true);
+
+    // Override (), allowing to use polynomial as function that interpolates
+    TYPE operator()(TYPE x) const;
+
+    // Evaluate the polynomial at count points, writing values into out.
+    void evaluate(const TYPE *xs, TYPE *out, size_t count) const;
+
+    // Evaluate the derivative at count points, without constructing the derivative polynomial.
+    void evaluate_derivative(const TYPE *xs, TYPE *out, size_t count) const;
+
+    // Evaluate the integral (with the constant C) at count points, without constructing the integral polynomial.
+    void evaluate_integral(const TYPE *xs, TYPE *out, size_t count, TYPE C = 0) const;
+
+    DynamicPolynomial differentiate() const;
+
+    DynamicPolynomial integrate(TYPE C = 0) const;
+
+    // Define [] to retrieve the coefficients
+    PRECISION &operator[](int a);
+
+    const PRECISION &operator[](int a) const;
+
+    PRECISION *begin();
+
+    PRECISION *end();
+
+    const PRECISION *begin() const;
+
+    const PRECISION *end() const;
+
+    // The order (highest degree) of the polynomial. This is one less than the number of coefficients.
+    int order() const;
+
+    // The number of data points that were in the data set.
+    int data_size() const;
+
+    // The raw sum of squared differences between data point Y value and predicted value.
+    // Only available if residuals were asked to be calculated.
+    PRECISION residual() const;
+
+    // The average of squared differences between data point Y value and predicted value.
+    // Only available if residuals were asked to be calculated.
+    PRECISION avg_sqdif() const;
+
+    void residual(PRECISION residual);
+
+    // The coefficient of determination, 1 - residual / (sum of squared differences between Y and its mean).
+    // Only available if residuals were asked to be calculated.
+    PRECISION r_squared() const;
+
+    void r_squared(PRECISION r_squared);
+
+    std::string DebugString() const;
+
+  private:
+    SmallBuffer<PRECISION, inline_coefficients> coefficients_;
+    bool valid_;
+
+    PRECISION residual_ = NAN;
+    PRECISION r_squared_ = NAN;
+    int data_size_ = 0;
+  };
+
+#include "internal/DynamicPolynomial.tpp"
+}
+
+#endif //POLYNOMIAL_DYNAMIC_POLYNOMIAL_H
@@ -0,0 +1,61 @@
+#ifndef POLYNOMIAL_REGRESSION_FIT_STATS_H
+#define POLYNOMIAL_REGRESSION_FIT_STATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace andviane {
+
+// Statistics of polynomial regression, filled by the overloads that take FitStats. The overloads without it
+// do not measure anything. The same instance can be passed to many fits to aggregate them, and instances can be
+// summed up (for instance, one per thread).
+  struct FitStats {
+    // The number of fits and of data points over all fits.
+    size_t fits = 0;
+    size_t data_points = 0;
+
+    // Time spent in the pass over data, accumulating the sums that make the normal matrix and the right hand side.
+    std::chrono::nanoseconds accumulation{0};
+
+    // Time spent in the elimination (LU factorization) and substitution.
+    std::chrono::nanoseconds elimination{0};
+
+    // Time spent computing the residual and R^2.
+    std::chrono::nanoseconds residual{0};
+
+    // Heap memory allocated by the regression.
+    size_t bytes_allocated = 0;
+
+    // Row swaps made by pivotisation.
+    size_t pivot_swaps = 0;
+
+    // The smallest absolute pivot of the elimination. Small pivots mean the loss of precision.
+    double min_pivot = INFINITY;
+
+    // The condition number of the normal matrix (1-norm), the largest over all fits and the one of the last fit.
+    // The relative error of coefficients may be up to this number times the relative error of the sums.
+    // Orders up to 2 fitted over X and Y accumulate X relative to the first data point, so this is
+    // the condition of the shifted matrix.
+    double max_condition = 0;
+    double last_condition = NAN;
+
+    FitStats &operator+=(const FitStats &other) {
+      fits += other.fits;
+      data_points += other.data_points;
+      accumulation += other.accumulation;
+      elimination += other.elimination;
+      residual += other.residual;
+      bytes_allocated += other.bytes_allocated;
+      pivot_swaps += other.pivot_swaps;
+      min_pivot = std::min(min_pivot, other.min_pivot);
+      max_condition = std::max(max_condition, other.max_condition);
+      if (other.fits > 0)
+        last_condition = other.last_condition;
+      return *this;
+    }
+  };
+}
+
+#endif //POLYNOMIAL_REGRESSION_FIT_STATS_H
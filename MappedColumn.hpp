@@ -0,0 +1,83 @@
+#ifndef POLYNOMIAL_REGRESSION_MAPPED_COLUMN_H
+#define POLYNOMIAL_REGRESSION_MAPPED_COLUMN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "polynomial_regression.hpp"
+
+// Fitting over flat binary column files that are memory mapped rather than loaded. POSIX only, this header
+// is not included by polynomial_regression.hpp.
+
+namespace andviane {
+
+// Type of values in the column file. Values are stored one after another, little-endian, without any header.
+  enum class ColumnType {
+    FLOAT32,
+    FLOAT64,
+    UINT8
+  };
+
+// Read only memory mapping of the binary column file. The kernel is advised that the mapping will be
+// read sequentially, so it reads ahead and drops the pages behind.
+  class MappedColumn {
+  public:
+    MappedColumn() = default;
+
+    MappedColumn(const MappedColumn &) = delete;
+
+    MappedColumn &operator=(const MappedColumn &) = delete;
+
+    MappedColumn(MappedColumn &&other) noexcept;
+
+    MappedColumn &operator=(MappedColumn &&other) noexcept;
+
+    ~MappedColumn();
+
+    // Map the file of values of the given type. Returns false (with errno set) if the file cannot be opened or
+    // mapped, or EINVAL if its size is not a multiple of the size of the value.
+    bool open(const std::string &path, ColumnType type);
+
+    void close();
+
+    // The number of values in the column.
+    size_t size() const;
+
+    ColumnType type() const;
+
+    // Size of a single value in bytes.
+    static size_t value_size(ColumnType type);
+
+    // Pointer to the first mapped byte.
+    const uint8_t *data() const;
+
+  private:
+    const uint8_t *data_ = nullptr;
+    size_t bytes_ = 0;
+    ColumnType type_ = ColumnType::FLOAT64;
+  };
+
+// Perform polynomial regression over count values of mapped X and Y columns starting from the value from.
+// Float and double columns on little-endian hosts are fitted in place, using vectorized kernels.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression_mapped(const MappedColumn &x, const MappedColumn &y,
+                                                                  size_t from = 0, size_t count = SIZE_MAX);
+
+// Perform polynomial regression over count values of mapped Y column starting from the value from,
+// X enumerating 0 to count - 1.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression_mapped(const MappedColumn &y,
+                                                                  size_t from = 0, size_t count = SIZE_MAX);
+
+#include "internal/MappedColumn.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_MAPPED_COLUMN_H
@@ -0,0 +1,61 @@
+#ifndef POLYNOMIAL_REGRESSION_ORTHOGONAL_FIT_H
+#define POLYNOMIAL_REGRESSION_ORTHOGONAL_FIT_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "Polynomial.hpp"
+#include "internal/ChebyshevQr.hpp"
+
+namespace andviane {
+
+// Criteria for the automatic selection of the polynomial degree. Both penalize the residual with
+// the number of coefficients: AIC = N * ln(residual / N) + 2 * (degree + 1),
+// BIC = N * ln(residual / N) + ln(N) * (degree + 1). BIC prefers lower degrees.
+  enum class DegreeCriterion {
+    AIC,
+    BIC
+  };
+
+// Fits of every degree 0 .. n over the same data, obtained from a single factorization. The data are projected on
+// the orthogonal basis (QR factorization in the Chebyshev basis), so a fit of a lower degree is just the leading
+// part of the same factorization, and its residual is the known sum of the remaining components.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE>
+  class OrthogonalFit {
+  public:
+    explicit OrthogonalFit(const ChebyshevQr<n, PRECISION> &qr);
+
+    // The residual (sum of squared differences) of the fit of the given degree.
+    PRECISION residual(int degree) const;
+
+    // The fit of the given degree. The coefficients above this degree are zero.
+    Polynomial<n, TYPE, PRECISION> polynomial(int degree) const;
+
+    // The fit of the degree k, with exactly k + 1 coefficients.
+    template<int k>
+    Polynomial<k, TYPE, PRECISION> polynomial() const;
+
+    // Select the degree with the lowest value of the criterion.
+    int select_degree(DegreeCriterion criterion = DegreeCriterion::AIC) const;
+
+    // Select the lowest degree whose residual cannot be reduced by more than the given fraction, like 0.01,
+    // with any higher degree up to n.
+    int select_degree(PRECISION min_relative_drop) const;
+
+    // The number of data points.
+    size_t data_size() const;
+
+  private:
+    // Store coefficients, residual and R^2 of the given degree into the polynomial.
+    template<int k>
+    void fill(int degree, Polynomial<k, TYPE, PRECISION> &polynomial) const;
+
+    ChebyshevQr<n, PRECISION> qr_;
+  };
+
+#include "internal/OrthogonalFit.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_ORTHOGONAL_FIT_H
@@ -0,0 +1,83 @@
+#ifndef POLYNOMIAL_PIECEWISE_POLYNOMIAL_H
+#define POLYNOMIAL_PIECEWISE_POLYNOMIAL_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "internal/regression_kernels.hpp"
+
+namespace andviane {
+
+// Polynomials of the same order over consecutive segments of X, separated by knots. The segment s covers
+// [knot(s), knot(s + 1)[, and its polynomial is of the local coordinate x - knot(s). Values below the first
+// knot use the first segment, values above the last knot use the last segment.
+//
+// The coefficients of all segments are stored in a single array. The segment of x is found using a uniform grid
+// over the knots: each cell of the grid knows the segments it overlaps, and only if there are several the binary
+// search is needed among them. Equally spaced knots get one cell per segment and do not need it, unless
+// the rounding moves a knot across the cell boundary.
+  template<int p_order, typename TYPE=double, typename PRECISION = TYPE>
+  class PiecewisePolynomial {
+  public:
+    PiecewisePolynomial() = default;
+
+    // knots are segments + 1 increasing values. coefficients are (p_order + 1) values per segment, for the powers
+    // of the local coordinate 0 .. p_order.
+    PiecewisePolynomial(std::vector<PRECISION> knots, std::vector<PRECISION> coefficients);
+
+    // Override (), allowing to use polynomial as function that interpolates
+    TYPE operator()(TYPE x) const;
+
+    // Evaluate at count points, writing values into out.
+    void evaluate(const TYPE *xs, TYPE *out, size_t count) const;
+
+    // The segment that contains x.
+    size_t segment_of(TYPE x) const;
+
+    // The number of segments.
+    size_t segments() const;
+
+    // The number of cells of the lookup grid overlapped by several segments, where the binary search is needed.
+    size_t ambiguous_cells() const;
+
+    // The knot i, 0 .. segments(). The segment s starts at knot(s).
+    PRECISION knot(size_t i) const;
+
+    // The p_order + 1 coefficients of the segment.
+    const PRECISION *coefficients(size_t segment) const;
+
+    // The number of data points that were in the data set.
+    int data_size() const;
+
+    void data_size(int n);
+
+    // The raw sum of squared differences between data point Y value and predicted value, over all segments.
+    PRECISION residual() const;
+
+    void residual(PRECISION residual);
+
+  private:
+    // The cell of the lookup grid that contains x, knots_[0] <= x <= knots_.back().
+    size_t cell_of(PRECISION x) const;
+
+    std::vector<PRECISION> knots_;
+    std::vector<PRECISION> coefficients_;
+
+    // The first and the last segment overlapping every cell of the lookup grid.
+    std::vector<size_t> cell_first_;
+    std::vector<size_t> cell_last_;
+    PRECISION cell_scale_ = 0;
+
+    PRECISION residual_ = NAN;
+    int data_size_ = 0;
+  };
+
+#include "internal/PiecewisePolynomial.tpp"
+}
+
+#endif //POLYNOMIAL_PIECEWISE_POLYNOMIAL_H
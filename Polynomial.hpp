@@ -1,8 +1,20 @@
 #ifndef POLYNOMIAL_POLYNOMIAL_H
 #define POLYNOMIAL_POLYNOMIAL_H
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
 #include <type_traits>
 
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include "internal/regression_kernels.hpp"
+
 namespace andviane {
 
 // A helper class that contains coefficients of polynomial,
@@ -15,15 +27,38 @@ namespace andviane {
     Polynomial(std::array<PRECISION, p_order + 1> coefficients, bool valid = true, int n = 0);
 
     // Override (), allowing to use polynomial as function that interpolates
-    TYPE operator()(TYPE x);
+    TYPE operator()(TYPE x) const;
+
+    // Evaluate the polynomial at count points, writing values into out. Points are processed in blocks,
+    // so that the compiler can vectorize Horner's scheme across them.
+    void evaluate(const TYPE *xs, TYPE *out, size_t count) const;
+
+    // Evaluate the polynomial at every point from first to last, writing values into out.
+    template<typename ITERATOR_IN, typename ITERATOR_OUT>
+    void evaluate_iter(ITERATOR_IN first, ITERATOR_IN last, ITERATOR_OUT out) const;
+
+    // Evaluate the derivative at count points, without constructing the derivative polynomial.
+    void evaluate_derivative(const TYPE *xs, TYPE *out, size_t count) const;
+
+    // Evaluate the integral (with the constant C) at count points, without constructing the integral polynomial.
+    void evaluate_integral(const TYPE *xs, TYPE *out, size_t count, TYPE C = 0) const;
+
+#if __cplusplus >= 202002L
+    // Evaluate the polynomial at every point of xs, writing values into out that must be at least as long.
+    void evaluate(std::span<const TYPE> xs, std::span<TYPE> out) const {
+      evaluate(xs.data(), out.data(), std::min(xs.size(), out.size()));
+    }
+#endif
 
-    Polynomial<p_order - 1, TYPE, PRECISION> differentiate();
+    Polynomial<p_order - 1, TYPE, PRECISION> differentiate() const;
 
-    Polynomial<p_order + 1, TYPE, PRECISION> integrate(TYPE C = 0);
+    Polynomial<p_order + 1, TYPE, PRECISION> integrate(TYPE C = 0) const;
 
     // Define [] to retrieve the coefficients
     PRECISION &operator[](int a);
 
+    const PRECISION &operator[](int a) const;
+
     // Define the begin() iterator for easy loop over polynomial variables, for (auto c: polynomial) {}
     typename std::array<PRECISION, p_order>::iterator begin();
 
@@ -46,6 +81,19 @@ namespace andviane {
 
     void residual(PRECISION residual);
 
+    // The coefficient of determination, 1 - residual / (sum of squared differences between Y and its mean).
+    // Only available if residuals were asked to be calculated.
+    PRECISION r_squared() const;
+
+    void r_squared(PRECISION r_squared);
+
+    // The number of binary digits of the floating point type the coefficients were computed in. This is less
+    // than the digits of PRECISION if polynomial_regression_escalating found the faster type accurate enough.
+    // Zero if PRECISION does not specialize std::numeric_limits.
+    int precision_digits() const;
+
+    void precision_digits(int digits);
+
     std::string DebugString() const;
 
   private:
@@ -53,7 +101,9 @@ namespace andviane {
     bool valid_;
 
     PRECISION residual_ = NAN;
+    PRECISION r_squared_ = NAN;
     int data_size_ = 0;
+    int precision_digits_ = std::numeric_limits<PRECISION>::digits;
   };
 
 #include "internal/Polynomial.tpp"
@@ -0,0 +1,87 @@
+#ifndef POLYNOMIAL_POLYNOMIAL_2D_H
+#define POLYNOMIAL_POLYNOMIAL_2D_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "internal/regression_kernels.hpp"
+
+namespace andviane {
+
+// Polynomial of two variables z = f(x, y) with the total degree p_degree, the sum of c(i, j) * x^i * y^j
+// over i + j <= p_degree.
+  template<int p_degree, typename TYPE=double, typename PRECISION = TYPE>
+  class Polynomial2D {
+  public:
+    // The number of coefficients.
+    static constexpr int terms = (p_degree + 1) * (p_degree + 2) / 2;
+
+    Polynomial2D(int n = 0, bool valid = true);
+
+    // Coefficients are ordered by the degree of x, then by the degree of y, see index.
+    Polynomial2D(std::array<PRECISION, terms> coefficients, bool valid = true, int n = 0);
+
+    // The position of the coefficient of x^i * y^j, i + j <= p_degree. The coefficients of x^0 * y^j come first,
+    // followed by x^1 * y^j and so on.
+    static constexpr int index(int i, int j) {
+      return monomial_index(p_degree, i, j);
+    }
+
+    // Override (), allowing to use polynomial as function that interpolates
+    TYPE operator()(TYPE x, TYPE y) const;
+
+    // Evaluate the polynomial at count points (xs[i], ys[i]), writing values into out. Points are processed in
+    // blocks, so that the compiler can vectorize the evaluation across them.
+    void evaluate(const TYPE *xs, const TYPE *ys, TYPE *out, size_t count) const;
+
+    // Evaluate the polynomial on the grid, writing the value at (xs[c], ys[r]) into out[r * nx + c]. Each row is
+    // a polynomial of x only, so the grid costs about as much as evaluating the polynomial of one variable.
+    void evaluate_grid(const TYPE *xs, size_t nx, const TYPE *ys, size_t ny, TYPE *out) const;
+
+    // The coefficient of x^i * y^j.
+    PRECISION &coefficient(int i, int j);
+
+    const PRECISION &coefficient(int i, int j) const;
+
+    // Define [] to retrieve the coefficients in the order of index.
+    PRECISION &operator[](int a);
+
+    const PRECISION &operator[](int a) const;
+
+    // The total degree of the polynomial.
+    int degree() const;
+
+    // The number of data points that were in the data set.
+    int data_size() const;
+
+    // The raw sum of squared differences between data point Z value and predicted value.
+    PRECISION residual() const;
+
+    void residual(PRECISION residual);
+
+    // The coefficient of determination, 1 - residual / (sum of squared differences between Z and its mean).
+    PRECISION r_squared() const;
+
+    void r_squared(PRECISION r_squared);
+
+    std::string DebugString() const;
+
+  private:
+    // Coefficients of the polynomial of x, c(i, y) = sigma(c(i, j) * y^j), written into q.
+    void coefficients_of_x(PRECISION y, PRECISION *q) const;
+
+    std::array<PRECISION, terms> coefficients_;
+    bool valid_;
+
+    PRECISION residual_ = NAN;
+    PRECISION r_squared_ = NAN;
+    int data_size_ = 0;
+  };
+
+#include "internal/Polynomial2D.tpp"
+}
+
+#endif //POLYNOMIAL_POLYNOMIAL_2D_H
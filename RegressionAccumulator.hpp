@@ -0,0 +1,109 @@
+#ifndef POLYNOMIAL_REGRESSION_ACCUMULATOR_H
+#define POLYNOMIAL_REGRESSION_ACCUMULATOR_H
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Polynomial.hpp"
+#include "internal/polynomial_regression_internals.hpp"
+#include "internal/simd_kernels.hpp"
+
+namespace andviane {
+
+// Streaming polynomial regression. Data points are consumed one at a time and only the sums required
+// by the normal equations are kept: 2n+1 sums of x raised in degree, n+1 sums of x raised in degree
+// multiplied by y and the sum of y squared. Memory usage does not depend on the number of data points, and each
+// point is visited only once, so this also works with single pass input iterators.
+//
+// The sums are sufficient statistics: accumulators over different parts of the data can be merged (or
+// retracted), and serialized into a few hundred bytes to be shipped between processes.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE>
+  class RegressionAccumulator {
+  public:
+    RegressionAccumulator();
+
+    // Add a single data point.
+    void add(PRECISION x, PRECISION y);
+
+    // Add N data points using X and Y iterators. Each iterator is dereferenced and incremented once per point.
+    // Pointers to float or double use vectorized kernels if PRECISION is also float or double.
+    template<typename ITERATOR_X, typename ITERATOR_Y>
+    void add(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N);
+
+    // Remove the data point that was previously added, for instance leaving the sliding window.
+    void remove(PRECISION x, PRECISION y);
+
+    // Add all data points of another accumulator, as if they were added to this one.
+    void merge(const RegressionAccumulator &other);
+
+    // Remove all data points of another accumulator that were previously merged into this one.
+    void retract(const RegressionAccumulator &other);
+
+    // Move all data points added so far by dx along the X axis (x becomes x + dx). This costs O(n^2)
+    // and does not depend on the number of the data points.
+    void shift(PRECISION dx);
+
+    // Solve the normal equations, obtaining the fitted polynomial. The residual and R^2 are also computed from
+    // the sums. The accumulator can be used further after that.
+    Polynomial<n, TYPE, PRECISION> solve() const;
+
+    // The number of data points added so far.
+    size_t size() const;
+
+    // Forget all data points added so far.
+    void clear();
+
+    // Serialize the sums into a compact binary form. The format starts with a magic and a version, followed by
+    // the order, the size of PRECISION, the number of data points (64 bit) and the sums, all little-endian.
+    // The values of PRECISION are copied as they are, so both sides must use the same floating point type.
+    std::vector<uint8_t> serialize() const;
+
+    // Restore the sums from the serialized form. Returns false (leaving this accumulator unchanged) if the data
+    // is truncated, has a different version, order or size of PRECISION.
+    bool deserialize(const uint8_t *data, size_t size);
+
+    bool deserialize(const std::vector<uint8_t> &data);
+
+    // sigma(xi^k), k = 0 .. 2n
+    const std::array<PRECISION, 2 * n + 1> &x_sums() const;
+
+    // sigma(xi^k * yi), k = 0 .. n
+    const std::array<PRECISION, n + 1> &xy_sums() const;
+
+    // sigma(yi^2)
+    PRECISION yy_sum() const;
+
+  private:
+    static constexpr uint8_t serialization_magic[4] = {'P', 'R', 'A', 'C'};
+    static constexpr uint8_t serialization_version = 1;
+    static constexpr size_t serialization_header = sizeof(serialization_magic) + 1 + 2 + 1 + 8;
+    static constexpr size_t serialization_values = (2 * n + 1) + (n + 1) + 1;
+    // The x87 extended precision value takes 10 bytes, the rest of long double is padding.
+    static constexpr size_t serialization_value_bytes =
+        std::numeric_limits<PRECISION>::is_iec559 && std::numeric_limits<PRECISION>::digits == 64 &&
+        sizeof(PRECISION) > 10 ? 10 : sizeof(PRECISION);
+
+    // sigma(xi^k), k = 0 .. 2n
+    std::array<PRECISION, 2 * n + 1> x_sums_;
+
+    // sigma(xi^k * yi), k = 0 .. n
+    std::array<PRECISION, n + 1> xy_sums_;
+
+    // sigma(yi^2)
+    PRECISION yy_sum_;
+
+    size_t size_;
+  };
+
+#include "internal/RegressionAccumulator.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_ACCUMULATOR_H
@@ -0,0 +1,49 @@
+#ifndef POLYNOMIAL_REGRESSION_WORKSPACE_H
+#define POLYNOMIAL_REGRESSION_WORKSPACE_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace andviane {
+
+// Scratch buffers of the regression, to be reused across fits. The buffers only grow, so once they are
+// large enough for the order and the number of series (see reserve), fits using this workspace do not
+// allocate. The memory comes from the given memory resource. Not thread safe, use a workspace per thread.
+  template<typename PRECISION=double>
+  class RegressionWorkspace {
+  public:
+    explicit RegressionWorkspace(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    // Allocate buffers for the fits up to the given order with up to the given number of series.
+    void reserve(int order, size_t series = 1);
+
+    // Buffer for X = sigma(xi^k), k = 0 .. 2n, zero filled.
+    PRECISION *x_sums(int order);
+
+    // Buffer for Y = sigma(xi^k * yi), k = 0 .. n, for every series, zero filled.
+    PRECISION *xy_sums(int order, size_t series = 1);
+
+    // Buffer for YY = sigma(yi^2) for every series, zero filled.
+    PRECISION *yy_sums(size_t series = 1);
+
+    // Buffer for the factorized normal matrix, (n + 1) x (n + 1).
+    PRECISION *matrix(int order);
+
+    // Buffer for the permutation of rows of the normal matrix.
+    int *permutation(int order);
+
+    std::pmr::memory_resource *resource() const;
+
+  private:
+    std::pmr::vector<PRECISION> x_sums_;
+    std::pmr::vector<PRECISION> xy_sums_;
+    std::pmr::vector<PRECISION> yy_sums_;
+    std::pmr::vector<PRECISION> matrix_;
+    std::pmr::vector<int> permutation_;
+  };
+
+#include "internal/RegressionWorkspace.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_WORKSPACE_H
@@ -0,0 +1,61 @@
+#ifndef POLYNOMIAL_REGRESSION_SAVITZKY_GOLAY_H
+#define POLYNOMIAL_REGRESSION_SAVITZKY_GOLAY_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "internal/polynomial_regression_internals.hpp"
+
+namespace andviane {
+
+// Savitzky-Golay filter: the value or the derivative at every sample of the polynomial of order n fitted over the
+// window of samples around it, like calling polynomial_regression_fixed<n, window> and differentiate() per sample.
+// As the samples are equally spaced, the result is a linear combination of the Y values in the window, so
+// the kernels are derived from the fixed size projection once and the filter is a convolution costing
+// O(window) per sample.
+//
+// The window is centered on the sample if possible. The first and the last window / 2 samples use the first
+// or the last full window, evaluating its polynomial at the position of the sample instead.
+  template<int n, int window, typename TYPE=double, typename PRECISION=TYPE>
+  class SavitzkyGolayFilter {
+  public:
+    // derivative is the order of the derivative (0 to smooth), spacing is the distance between samples.
+    explicit SavitzkyGolayFilter(int derivative = 0, PRECISION spacing = 1);
+
+    // Filter count >= window samples from in to out, which must not overlap.
+    void apply(const TYPE *in, TYPE *out, size_t count) const;
+
+    // Filter the collection, returning the filtered values. Collections that are not contiguous arrays of TYPE
+    // are copied first.
+    template<typename COLLECTION_Y>
+    std::vector<TYPE> apply(const COLLECTION_Y &y) const;
+
+    // The weights of the window samples 0 .. window - 1 for the value at the given position in the window.
+    // The sample in the middle of the window uses the position window / 2.
+    const PRECISION *kernel(int position) const;
+
+    // The order of the derivative.
+    int derivative() const;
+
+  private:
+    // Convolve the samples in [from, to[ with the central kernel, the window starting window / 2 samples before.
+    void convolve(const TYPE *in, TYPE *out, size_t from, size_t to) const;
+
+    // Weighted sum of the window samples starting at in.
+    static PRECISION dot(const PRECISION *kernel, const TYPE *in);
+
+    static TYPE round(PRECISION v);
+
+    // The kernels of all positions, window values each.
+    std::vector<PRECISION> kernels_;
+    int derivative_;
+  };
+
+#include "internal/SavitzkyGolayFilter.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_SAVITZKY_GOLAY_H
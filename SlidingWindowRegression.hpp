@@ -0,0 +1,68 @@
+#ifndef POLYNOMIAL_REGRESSION_SLIDING_WINDOW_H
+#define POLYNOMIAL_REGRESSION_SLIDING_WINDOW_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "RegressionAccumulator.hpp"
+
+namespace andviane {
+
+// Polynomial regression over the last "window" data points. Adding a new point retracts the oldest one
+// from the sums of the normal equations, so the update costs O(n) (O(n^2) if X is enumerated) and
+// does not depend on the window size. The data points in the window are kept for retraction.
+//
+// The sums are updated incrementally, so the floating point error may accumulate over very long runs.
+// Call rebuild() occasionally to recompute the sums from the data points in the window, if this matters.
+// If X is enumerated, the sums of X only depend on the window size and are not kept. The sums of Y are
+// moved to the new origin on every step and rebuilt automatically once per window, so the error stays bounded.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE>
+  class SlidingWindowRegression {
+  public:
+    explicit SlidingWindowRegression(size_t window);
+
+    // Add the newest data point, retracting the oldest one if the window is full.
+    void add(PRECISION x, PRECISION y);
+
+    // Add the newest Y value, retracting the oldest one if the window is full. X is not stored but enumerates
+    // from 0 (the oldest data point in the window) to size() - 1 (the newest one). Do not mix with add(x, y).
+    void add(PRECISION y);
+
+    // Fit the polynomial over the data points currently in the window.
+    Polynomial<n, TYPE, PRECISION> solve() const;
+
+    // Recompute the sums from the data points in the window, discarding the accumulated rounding error.
+    void rebuild();
+
+    // The number of data points currently in the window.
+    size_t size() const;
+
+    // The maximal number of data points in the window.
+    size_t window() const;
+
+    // Remove all data points.
+    void clear();
+
+  private:
+    RegressionAccumulator<n, TYPE, PRECISION> accumulator_;
+
+    // Ring buffers holding the data points in the window. X is only used if not enumerated.
+    std::vector<PRECISION> x_;
+    std::vector<PRECISION> y_;
+
+    // If X is enumerated: sigma(xi^k * yi) for k = 0 .. n, sigma(yi^2) and the steps since the last rebuild.
+    std::array<PRECISION, n + 1> y_sums_{};
+    PRECISION yy_sum_ = 0;
+    size_t steps_ = 0;
+
+    size_t window_;
+    size_t oldest_ = 0;
+    bool enumerated_ = false;
+  };
+
+#include "internal/SlidingWindowRegression.tpp"
+}
+
+#endif //POLYNOMIAL_REGRESSION_SLIDING_WINDOW_H
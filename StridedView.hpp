@@ -0,0 +1,153 @@
+#ifndef POLYNOMIAL_REGRESSION_STRIDED_VIEW_H
+#define POLYNOMIAL_REGRESSION_STRIDED_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+
+namespace andviane {
+
+// Random access iterator over values that are stride bytes apart, like one member of an array of structs.
+  template<typename T>
+  class StridedIterator {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T *pointer;
+    typedef const T &reference;
+
+    StridedIterator(const T *at = nullptr, std::ptrdiff_t stride = sizeof(T)) :
+        at_((const char *) at), stride_(stride) {
+    }
+
+    const T &operator*() const {
+      return *(const T *) at_;
+    }
+
+    const T *operator->() const {
+      return (const T *) at_;
+    }
+
+    const T &operator[](std::ptrdiff_t i) const {
+      return *(const T *) (at_ + i * stride_);
+    }
+
+    StridedIterator &operator++() {
+      at_ += stride_;
+      return *this;
+    }
+
+    StridedIterator operator++(int) {
+      StridedIterator old = *this;
+      at_ += stride_;
+      return old;
+    }
+
+    StridedIterator &operator--() {
+      at_ -= stride_;
+      return *this;
+    }
+
+    StridedIterator operator--(int) {
+      StridedIterator old = *this;
+      at_ -= stride_;
+      return old;
+    }
+
+    StridedIterator &operator+=(std::ptrdiff_t i) {
+      at_ += i * stride_;
+      return *this;
+    }
+
+    StridedIterator &operator-=(std::ptrdiff_t i) {
+      at_ -= i * stride_;
+      return *this;
+    }
+
+    StridedIterator operator+(std::ptrdiff_t i) const {
+      return StridedIterator(*this) += i;
+    }
+
+    friend StridedIterator operator+(std::ptrdiff_t i, const StridedIterator &iterator) {
+      return iterator + i;
+    }
+
+    StridedIterator operator-(std::ptrdiff_t i) const {
+      return StridedIterator(*this) -= i;
+    }
+
+    std::ptrdiff_t operator-(const StridedIterator &other) const {
+      return (at_ - other.at_) / stride_;
+    }
+
+    bool operator==(const StridedIterator &other) const {
+      return at_ == other.at_;
+    }
+
+    bool operator!=(const StridedIterator &other) const {
+      return at_ != other.at_;
+    }
+
+    bool operator<(const StridedIterator &other) const {
+      return stride_ > 0 ? at_ < other.at_ : at_ > other.at_;
+    }
+
+    bool operator>(const StridedIterator &other) const {
+      return other < *this;
+    }
+
+    bool operator<=(const StridedIterator &other) const {
+      return !(other < *this);
+    }
+
+    bool operator>=(const StridedIterator &other) const {
+      return !(*this < other);
+    }
+
+  private:
+    const char *at_;
+    std::ptrdiff_t stride_;
+  };
+
+// Read only view over size values that are stride bytes apart, without copying them. It can be passed to
+// polynomial_regression as X or Y collection. For instance, the member value of the array of structs samples:
+// StridedView<double>(&samples[0].value, samples.size(), sizeof(samples[0]))
+  template<typename T>
+  class StridedView {
+  public:
+    StridedView(const T *first, size_t size, std::ptrdiff_t stride = sizeof(T)) :
+        first_(first), size_(size), stride_(stride) {
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    const T &operator[](size_t i) const {
+      return cbegin()[i];
+    }
+
+    StridedIterator<T> cbegin() const {
+      return StridedIterator<T>(first_, stride_);
+    }
+
+    StridedIterator<T> cend() const {
+      return cbegin() + size_;
+    }
+
+    StridedIterator<T> begin() const {
+      return cbegin();
+    }
+
+    StridedIterator<T> end() const {
+      return cend();
+    }
+
+  private:
+    const T *first_;
+    size_t size_;
+    std::ptrdiff_t stride_;
+  };
+}
+
+#endif //POLYNOMIAL_REGRESSION_STRIDED_VIEW_H
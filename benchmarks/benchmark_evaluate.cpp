@@ -0,0 +1,107 @@
+#include <list>
+#include <vector>
+#include "benchmark_support.hpp"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Polynomial of the given order with coefficients of decreasing magnitude.
+template<int order, typename TYPE, typename PRECISION>
+Polynomial<order, TYPE, PRECISION> make_polynomial() {
+  Polynomial<order, TYPE, PRECISION> polynomial;
+  for (int k = 0; k <= order; k++) {
+    polynomial[k] = (PRECISION) 1 / (k + 1);
+  }
+  return polynomial;
+}
+
+// Evaluation, one point at a time.
+template<int order, typename TYPE, typename PRECISION>
+void BM_Evaluate(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  std::vector<TYPE> y(N);
+  auto polynomial = make_polynomial<order, TYPE, PRECISION>();
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    for (size_t i = 0; i < N; i++) {
+      y[i] = polynomial(x[i]);
+    }
+    benchmark::DoNotOptimize(y.data());
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_Evaluate, 1, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_Evaluate, 2, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_Evaluate, 8, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_Evaluate, 64, double, long double)->RangeMultiplier(100)->Range(10, 1000000);
+
+// Batch evaluation, blocked Horner's scheme.
+template<int order, typename TYPE, typename PRECISION>
+void BM_EvaluateBatch(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  std::vector<TYPE> y(N);
+  auto polynomial = make_polynomial<order, TYPE, PRECISION>();
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    polynomial.evaluate(x.data(), y.data(), N);
+    benchmark::DoNotOptimize(y.data());
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, 1, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, 2, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, 8, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, 64, double, long double)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, 2, float, float)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_EvaluateBatch, 2, uint8_t, double)->RangeMultiplier(100)->Range(10, 10000000);
+
+// Batch evaluation from a container that is not contiguous.
+template<int order, typename TYPE, typename PRECISION>
+void BM_EvaluateList(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::list<TYPE>>(N, sample_x<TYPE>);
+  std::vector<TYPE> y(N);
+  auto polynomial = make_polynomial<order, TYPE, PRECISION>();
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    polynomial.evaluate_iter(x.cbegin(), x.cend(), y.begin());
+    benchmark::DoNotOptimize(y.data());
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_EvaluateList, 2, double, double)->RangeMultiplier(100)->Range(10, 1000000);
+
+// Evaluation of the polynomial with the order given at runtime.
+template<typename TYPE, typename PRECISION>
+void BM_EvaluateDynamic(benchmark::State &state) {
+  size_t N = state.range(0);
+  int order = (int) state.range(1);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  std::vector<TYPE> y(N);
+  DynamicPolynomial<TYPE, PRECISION> polynomial(order);
+  for (int k = 0; k <= order; k++) {
+    polynomial[k] = (PRECISION) 1 / (k + 1);
+  }
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    polynomial.evaluate(x.data(), y.data(), N);
+    benchmark::DoNotOptimize(y.data());
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_EvaluateDynamic, double, double)->ArgsProduct({{1000, 1000000}, {1, 2, 8}});
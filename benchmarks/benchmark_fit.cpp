@@ -0,0 +1,245 @@
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <vector>
+#include "benchmark_support.hpp"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Fit over two collections. forward_list has no size() so it goes through the iterator API.
+template<int order, typename TYPE, typename PRECISION, typename CONTAINER>
+Polynomial<order, TYPE, PRECISION> fit(const CONTAINER &x, const CONTAINER &y, size_t N) {
+  if constexpr (std::is_same<CONTAINER, std::forward_list<TYPE>>::value) {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), false, N);
+  } else {
+    return polynomial_regression<order, TYPE, PRECISION>(x, y);
+  }
+}
+
+// Fit of the given order over X and Y, range(0) data points.
+template<int order, typename TYPE, typename PRECISION, typename CONTAINER>
+void BM_Fit(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<CONTAINER>(N, sample_x<TYPE>);
+  auto y = make_samples<CONTAINER>(N, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto polynomial = fit<order, TYPE, PRECISION>(x, y, N);
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N);
+}
+
+// Orders over std::vector
+BENCHMARK_TEMPLATE(BM_Fit, 1, double, double, std::vector<double>)->RangeMultiplier(10)->Range(10, 100000000);
+BENCHMARK_TEMPLATE(BM_Fit, 2, double, double, std::vector<double>)->RangeMultiplier(10)->Range(10, 100000000);
+BENCHMARK_TEMPLATE(BM_Fit, 8, double, double, std::vector<double>)->RangeMultiplier(10)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_Fit, 64, double, long double, std::vector<double>)->RangeMultiplier(10)->Range(100, 100000);
+
+// Containers
+BENCHMARK_TEMPLATE(BM_Fit, 2, double, double, std::deque<double>)->RangeMultiplier(10)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_Fit, 2, double, double, std::list<double>)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Fit, 2, double, double, std::forward_list<double>)->RangeMultiplier(10)->Range(10, 1000000);
+
+// Types and precisions
+BENCHMARK_TEMPLATE(BM_Fit, 2, uint8_t, double, std::vector<uint8_t>)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Fit, 2, float, float, std::vector<float>)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Fit, 2, float, double, std::vector<float>)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Fit, 2, double, long double, std::vector<double>)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Fit, 8, long double, long double, std::vector<long double>)
+    ->RangeMultiplier(100)->Range(10, 1000000);
+#ifdef __SIZEOF_FLOAT128__
+BENCHMARK_TEMPLATE(BM_Fit, 2, double, __float128, std::vector<double>)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_Fit, 64, double, __float128, std::vector<double>)->RangeMultiplier(10)->Range(100, 10000);
+#endif
+
+// Fit over Y only, X enumerating 0 to N.
+template<int order, typename TYPE, typename PRECISION>
+void BM_FitY(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto y = make_samples<std::vector<TYPE>>(N, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto polynomial = polynomial_regression<order, TYPE, PRECISION>(y);
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_FitY, 2, double, double)->RangeMultiplier(100)->Range(10, 10000000);
+BENCHMARK_TEMPLATE(BM_FitY, 8, double, long double)->RangeMultiplier(100)->Range(10, 1000000);
+
+// Fit over the fixed number of Y values, X enumerating 0 to fixed_size - 1. Slides over a longer series,
+// each iteration fits one window.
+template<int order, int fixed_size, typename TYPE, typename PRECISION>
+void BM_FitFixed(benchmark::State &state) {
+  const size_t N = 1 << 16;
+  auto y = make_samples<std::vector<TYPE>>(N + fixed_size, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  size_t from = 0;
+  for (auto _: state) {
+    auto polynomial = polynomial_regression_iter<order, fixed_size, TYPE, PRECISION>(y.data() + from, false);
+    benchmark::DoNotOptimize(polynomial);
+    from = (from + 1) % N;
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, fixed_size, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_FitFixed, 1, 16, double, double);
+BENCHMARK_TEMPLATE(BM_FitFixed, 2, 16, double, double);
+BENCHMARK_TEMPLATE(BM_FitFixed, 2, 64, double, double);
+BENCHMARK_TEMPLATE(BM_FitFixed, 2, 256, double, double);
+BENCHMARK_TEMPLATE(BM_FitFixed, 8, 256, double, double);
+BENCHMARK_TEMPLATE(BM_FitFixed, 2, 64, float, float);
+BENCHMARK_TEMPLATE(BM_FitFixed, 2, 64, uint8_t, double);
+
+// Fit using multiple threads, range(1) threads (0 for all cores).
+template<int order, typename TYPE, typename PRECISION>
+void BM_FitParallel(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N, sample_y<TYPE>);
+  Parallel parallel;
+  parallel.threads = (unsigned) state.range(1);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto polynomial = polynomial_regression<order, TYPE, PRECISION>(x, y, parallel);
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N);
+}
+
+BENCHMARK_TEMPLATE(BM_FitParallel, 2, double, double)
+    ->ArgsProduct({{100000, 10000000, 100000000}, {0, 2, 4}})->UseRealTime();
+
+// Fit of range(1) series against the same X, range(0) data points in every series.
+template<int order, typename TYPE, typename PRECISION>
+void BM_FitBatch(benchmark::State &state) {
+  size_t N = state.range(0);
+  size_t series = state.range(1);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N * series, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto polynomials = polynomial_regression_batch_iter<order, TYPE, PRECISION>(x.data(), y.data(), N, series);
+    benchmark::DoNotOptimize(polynomials);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N * series, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_FitBatch, 2, double, double)->ArgsProduct({{100, 10000}, {1, 16, 256}});
+
+// The same, reusing the workspace and the results, so no allocations are expected.
+template<int order, typename TYPE, typename PRECISION>
+void BM_FitBatchWorkspace(benchmark::State &state) {
+  size_t N = state.range(0);
+  size_t series = state.range(1);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N * series, sample_y<TYPE>);
+  RegressionWorkspace<PRECISION> workspace;
+  workspace.reserve(order, series);
+  std::vector<Polynomial<order, TYPE, PRECISION>> polynomials(series);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    polynomial_regression_batch_iter<order, TYPE, PRECISION>(x.data(), y.data(), N, series, workspace,
+                                                             polynomials.data());
+    benchmark::DoNotOptimize(polynomials.data());
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N * series, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_FitBatchWorkspace, 2, double, double)->ArgsProduct({{100, 10000}, {1, 16, 256}});
+
+// Numerically stable fit, QR in the Chebyshev basis.
+template<int order, typename TYPE, typename PRECISION>
+void BM_FitStable(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto polynomial = polynomial_regression_stable<order, TYPE, PRECISION>(x, y);
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N);
+}
+
+BENCHMARK_TEMPLATE(BM_FitStable, 2, double, double)->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK_TEMPLATE(BM_FitStable, 8, double, double)->RangeMultiplier(100)->Range(10, 1000000);
+
+// Fits of all degrees up to the order with the degree selection.
+template<int order, typename TYPE, typename PRECISION>
+void BM_FitAll(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto all = polynomial_regression_all<order, TYPE, PRECISION>(x, y);
+    auto polynomial = all.polynomial(all.select_degree());
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N);
+}
+
+BENCHMARK_TEMPLATE(BM_FitAll, 8, double, double)->RangeMultiplier(100)->Range(10, 1000000);
+
+// Fit of the order given at runtime, range(1).
+template<typename TYPE, typename PRECISION>
+void BM_FitDynamic(benchmark::State &state) {
+  size_t N = state.range(0);
+  int order = (int) state.range(1);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    auto polynomial = polynomial_regression_dynamic<TYPE, PRECISION>(order, x, y);
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N);
+}
+
+BENCHMARK_TEMPLATE(BM_FitDynamic, double, double)->ArgsProduct({{100, 1000000}, {1, 2, 8}});
+BENCHMARK_TEMPLATE(BM_FitDynamic, double, long double)->ArgsProduct({{100, 100000}, {64}});
+
+// Incremental fit, adding points one by one and solving at the end.
+template<int order, typename TYPE, typename PRECISION>
+void BM_Accumulator(benchmark::State &state) {
+  size_t N = state.range(0);
+  auto x = make_samples<std::vector<TYPE>>(N, sample_x<TYPE>);
+  auto y = make_samples<std::vector<TYPE>>(N, sample_y<TYPE>);
+
+  AllocationCounter allocations;
+  for (auto _: state) {
+    RegressionAccumulator<order, TYPE, PRECISION> accumulator;
+    for (size_t i = 0; i < N; i++) {
+      accumulator.add(x[i], y[i]);
+    }
+    auto polynomial = accumulator.solve();
+    benchmark::DoNotOptimize(polynomial);
+  }
+  allocations.report(state);
+  report_samples<TYPE>(state, N);
+}
+
+BENCHMARK_TEMPLATE(BM_Accumulator, 2, double, double)->RangeMultiplier(100)->Range(10, 1000000);
@@ -0,0 +1,28 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "benchmark_support.hpp"
+
+std::atomic<size_t> allocated_bytes{0};
+std::atomic<size_t> allocation_count{0};
+
+// Count heap allocations, so that benchmarks can report bytes allocated per fit.
+void *operator new(size_t size) {
+  allocated_bytes += size;
+  allocation_count++;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+// Use --benchmark_out=results.json --benchmark_out_format=json to save results for regression tracking.
+BENCHMARK_MAIN();
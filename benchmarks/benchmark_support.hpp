@@ -0,0 +1,79 @@
+#ifndef POLYNOMIAL_REGRESSION_BENCHMARK_SUPPORT_H
+#define POLYNOMIAL_REGRESSION_BENCHMARK_SUPPORT_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <type_traits>
+#include "benchmark/benchmark.h"
+
+// Heap allocations of the benchmark binary, counted by the replaced operator new in benchmark_main.cpp
+extern std::atomic<size_t> allocated_bytes;
+extern std::atomic<size_t> allocation_count;
+
+// Reports the heap allocations made between construction and report() as average per iteration.
+class AllocationCounter {
+public:
+  AllocationCounter() : bytes_(allocated_bytes), count_(allocation_count) {
+  }
+
+  void report(benchmark::State &state) const {
+    // Read both before the counters are inserted, as the insertion allocates.
+    double bytes = (double) (allocated_bytes - bytes_);
+    double count = (double) (allocation_count - count_);
+    state.counters["bytes_allocated"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+    state.counters["allocations"] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  size_t bytes_;
+  size_t count_;
+};
+
+// Report the throughput in samples (data points) per second and in bytes of input per second.
+template<typename TYPE>
+void report_samples(benchmark::State &state, size_t samples_per_iteration, int values_per_sample = 2) {
+  state.SetItemsProcessed((int64_t) state.iterations() * (int64_t) samples_per_iteration);
+  state.SetBytesProcessed((int64_t) state.iterations() * (int64_t) samples_per_iteration
+                          * values_per_sample * (int64_t) sizeof(TYPE));
+}
+
+// X of the sample i out of N, in [-1, 1] for floating point types.
+template<typename TYPE>
+TYPE sample_x(size_t i, size_t N) {
+  if constexpr (std::is_integral<TYPE>::value) {
+    return (TYPE) (i % 256);
+  } else {
+    return (TYPE) (2.0 * (double) i / (double) N - 1.0);
+  }
+}
+
+// Y of the sample i out of N, a smooth curve with some deterministic noise.
+template<typename TYPE>
+TYPE sample_y(size_t i, size_t N) {
+  if constexpr (std::is_integral<TYPE>::value) {
+    return (TYPE) ((i * 7 + i / 3) % 256);
+  } else {
+    double x = 2.0 * (double) i / (double) N - 1.0;
+    return (TYPE) (std::sin(3 * x) + 0.01 * std::sin((double) i * 12.9898));
+  }
+}
+
+// Fill the container with N values produced by the generator.
+template<typename CONTAINER, typename GENERATOR>
+CONTAINER make_samples(size_t N, GENERATOR generator) {
+  CONTAINER container;
+  if constexpr (std::is_same<CONTAINER, std::forward_list<typename CONTAINER::value_type>>::value) {
+    // Insert in reverse, as forward_list only grows at the front.
+    for (size_t i = N; i > 0; --i)
+      container.push_front(generator(i - 1, N));
+  } else {
+    for (size_t i = 0; i < N; ++i)
+      container.push_back(generator(i, N));
+  }
+  return container;
+}
+
+#endif //POLYNOMIAL_REGRESSION_BENCHMARK_SUPPORT_H
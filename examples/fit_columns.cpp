@@ -0,0 +1,150 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../MappedColumn.hpp"
+
+// Fits polynomials over flat binary column files without loading them into memory.
+//
+// fit_columns [-o order] [-x file[:type]] [-r from:count]... file[:type]...
+//
+// Every Y file is fitted over every row range (the whole file if no ranges are given) against the X file,
+// or against the row number within the range if X is not given. The type is f32, f64 (default) or u8.
+// Prints one line per fit with the coefficients, the residual and R^2.
+
+using namespace andviane;
+
+namespace {
+  constexpr int max_order = 9;
+
+  struct Range {
+    size_t from;
+    size_t count;
+  };
+
+  void usage() {
+    fprintf(stderr, "Usage: fit_columns [-o order] [-x file[:type]] [-r from:count]... file[:type]...\n"
+                    "  order is 0 .. %d (default 2), type is f32, f64 (default) or u8\n", max_order);
+  }
+
+  // Split "file:type" into the path and the column type. Returns false if the type is not known.
+  bool parse_column(const std::string &argument, std::string &path, ColumnType &type) {
+    size_t colon = argument.rfind(':');
+    std::string suffix = colon == std::string::npos ? "" : argument.substr(colon + 1);
+    path = argument;
+    type = ColumnType::FLOAT64;
+    if (suffix == "f32") {
+      type = ColumnType::FLOAT32;
+    } else if (suffix == "u8") {
+      type = ColumnType::UINT8;
+    } else if (suffix != "f64") {
+      return colon == std::string::npos;
+    }
+    path = argument.substr(0, colon);
+    return true;
+  }
+
+  bool open_column(const std::string &argument, MappedColumn &column, std::string &path) {
+    ColumnType type;
+    if (!parse_column(argument, path, type)) {
+      fprintf(stderr, "%s: unknown column type\n", argument.c_str());
+      return false;
+    }
+    if (!column.open(path, type)) {
+      fprintf(stderr, "%s: %s\n", path.c_str(), strerror(errno));
+      return false;
+    }
+    return true;
+  }
+
+  // Fit of the order given at runtime, instantiating the fixed order fits up to max_order.
+  template<int order = 0>
+  DynamicPolynomial<double> fit(int n, const MappedColumn *x, const MappedColumn &y, Range range) {
+    if constexpr (order < max_order) {
+      if (n > order)
+        return fit<order + 1>(n, x, y, range);
+    }
+    if (x != nullptr)
+      return polynomial_regression_mapped<order>(*x, y, range.from, range.count);
+    return polynomial_regression_mapped<order>(y, range.from, range.count);
+  }
+}
+
+int main(int argc, char **argv) {
+  int order = 2;
+  std::string x_argument;
+  std::vector<Range> ranges;
+  std::vector<std::string> y_arguments;
+
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    bool has_value = i + 1 < argc;
+    if (argument == "-o" && has_value) {
+      order = atoi(argv[++i]);
+    } else if (argument == "-x" && has_value) {
+      x_argument = argv[++i];
+    } else if (argument == "-r" && has_value) {
+      unsigned long long from;
+      unsigned long long count;
+      if (sscanf(argv[++i], "%llu:%llu", &from, &count) != 2) {
+        usage();
+        return 2;
+      }
+      ranges.push_back({(size_t) from, (size_t) count});
+    } else if (argument[0] == '-') {
+      usage();
+      return 2;
+    } else {
+      y_arguments.push_back(argument);
+    }
+  }
+  if (order < 0 || order > max_order || y_arguments.empty()) {
+    usage();
+    return 2;
+  }
+
+  MappedColumn x;
+  std::string x_path;
+  if (!x_argument.empty() && !open_column(x_argument, x, x_path))
+    return 1;
+
+  printf("# file from count");
+  for (int k = 0; k <= order; k++)
+    printf(" a%d", k);
+  printf(" residual r_squared\n");
+
+  int status = 0;
+  for (const std::string &y_argument: y_arguments) {
+    MappedColumn y;
+    std::string y_path;
+    if (!open_column(y_argument, y, y_path)) {
+      status = 1;
+      continue;
+    }
+    if (!x_argument.empty() && x.size() != y.size()) {
+      fprintf(stderr, "%s: %zu values, but X has %zu\n", y_path.c_str(), y.size(), x.size());
+      status = 1;
+      continue;
+    }
+
+    std::vector<Range> file_ranges = ranges.empty() ? std::vector<Range>{{0, y.size()}} : ranges;
+    for (Range range: file_ranges) {
+      if (range.from >= y.size()) {
+        fprintf(stderr, "%s: range starts at %zu, but there are %zu values\n", y_path.c_str(), range.from,
+                y.size());
+        status = 1;
+        continue;
+      }
+      range.count = std::min(range.count, y.size() - range.from);
+
+      DynamicPolynomial<double> polynomial = fit(order, x_argument.empty() ? nullptr : &x, y, range);
+      printf("%s %zu %zu", y_path.c_str(), range.from, range.count);
+      for (int k = 0; k <= order; k++)
+        printf(" %.10g", polynomial[k]);
+      printf(" %.10g %.10g\n", polynomial.residual(), polynomial.r_squared());
+    }
+  }
+  return status;
+}
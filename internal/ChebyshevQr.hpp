@@ -0,0 +1,139 @@
+#ifndef _POLYNOMIAL_REGRESSION_ABC_CHEBYSHEV_QR_H
+#define _POLYNOMIAL_REGRESSION_ABC_CHEBYSHEV_QR_H  __POLYNOMIAL_REGRESSION_ABC_CHEBYSHEV_QR_H
+
+#include <cmath>
+#include <cstddef>
+
+namespace andviane {
+
+// Streaming QR factorization of the polynomial least squares problem. X is mapped into t = (x - center) / scale,
+// that should fall into [-1, 1], and the basis functions are Chebyshev polynomials T_k(t) that are nearly
+// orthogonal there. Every data point is a row of the least squares problem, merged into the triangular R with
+// Givens rotations, so the normal equations (that square the condition number) are never formed.
+//
+// The basis functions are ordered by degree, so the leading (m + 1) x (m + 1) block of R is the factorization
+// of the fit of degree m. Hence the same factorization provides the fits and residuals of every degree 0 .. n.
+  template<int n, typename PRECISION>
+  class ChebyshevQr {
+  public:
+    ChebyshevQr(PRECISION center, PRECISION scale) : center_(center), scale_(scale) {
+      static_assert(n >= 0);
+      for (int i = 0; i <= n; ++i) {
+        z_[i] = 0;
+        for (int j = 0; j <= n; ++j)
+          R_[i][j] = 0;
+      }
+    }
+
+    // Add a single data point.
+    void add(PRECISION x, PRECISION y) {
+      using std::sqrt;
+
+      // The row of the least squares problem, T_k(t)
+      PRECISION t = (x - center_) / scale_;
+      PRECISION v[n + 1];
+      v[0] = 1;
+      if (n > 0)
+        v[1] = t;
+      for (int k = 2; k <= n; ++k)
+        v[k] = 2 * t * v[k - 1] - v[k - 2];
+
+      // Rotate the row into R, zeroing it element by element. What remains from y is orthogonal to the basis.
+      for (int k = 0; k <= n; ++k) {
+        if (v[k] == 0)
+          continue;
+        PRECISION r = sqrt(R_[k][k] * R_[k][k] + v[k] * v[k]);
+        PRECISION c = R_[k][k] / r;
+        PRECISION s = v[k] / r;
+        R_[k][k] = r;
+        for (int j = k + 1; j <= n; ++j) {
+          PRECISION R_kj = R_[k][j];
+          R_[k][j] = c * R_kj + s * v[j];
+          v[j] = c * v[j] - s * R_kj;
+        }
+        PRECISION z_k = z_[k];
+        z_[k] = c * z_k + s * y;
+        y = c * y - s * z_k;
+      }
+      rest_ += y * y;
+      size_++;
+    }
+
+    // The residual (sum of squared differences) of the fit of the given degree.
+    PRECISION residual(int degree) const {
+      PRECISION r = rest_;
+      for (int k = degree + 1; k <= n; ++k)
+        r += z_[k] * z_[k];
+      return r;
+    }
+
+    // Compute the monomial coefficients a[0 .. degree] of the fit of the given degree, p(x) = sigma(a[k] * x^k).
+    void solve(int degree, PRECISION *a) const {
+      // Back substitution gives the Chebyshev coefficients.
+      PRECISION c[n + 1];
+      for (int i = degree; i >= 0; --i) {
+        c[i] = z_[i];
+        for (int j = i + 1; j <= degree; ++j)
+          c[i] -= R_[i][j] * c[j];
+        c[i] = R_[i][i] != 0 ? c[i] / R_[i][i] : 0;
+      }
+
+      // Sum up Chebyshev polynomials in the monomial form, T_1 = t, T_(k+1) = 2t * T_k - T_(k-1).
+      PRECISION b[n + 1] = {};
+      PRECISION T_previous[n + 1] = {};
+      PRECISION T[n + 1] = {};
+      T[0] = 1;
+      for (int k = 0; k <= degree; ++k) {
+        for (int j = 0; j <= k; ++j)
+          b[j] += c[k] * T[j];
+
+        PRECISION T_next[n + 1] = {};
+        for (int j = 0; j <= k && j < n; ++j)
+          T_next[j + 1] = (k == 0 ? 1 : 2) * T[j];
+        if (k > 0)
+          for (int j = 0; j < k; ++j)
+            T_next[j] -= T_previous[j];
+        for (int j = 0; j <= n; ++j) {
+          T_previous[j] = T[j];
+          T[j] = T_next[j];
+        }
+      }
+
+      // Undo scaling, b[j] * t^j = b[j] / scale^j * (x - center)^j
+      PRECISION scale_raised = 1;
+      for (int j = 0; j <= degree; ++j) {
+        b[j] /= scale_raised;
+        scale_raised *= scale_;
+      }
+
+      // Undo centering with Horner's scheme on polynomials: a = (...(b[m] * (x - center) + b[m-1]) ...) + b[0]
+      for (int j = 0; j <= degree; ++j)
+        a[j] = 0;
+      for (int j = degree; j >= 0; --j) {
+        // a = a * (x - center) + b[j]
+        for (int i = degree; i > 0; --i)
+          a[i] = a[i - 1] - center_ * a[i];
+        a[0] = b[j] - center_ * a[0];
+      }
+    }
+
+    // The number of data points added so far.
+    size_t size() const {
+      return size_;
+    }
+
+  private:
+    PRECISION center_;
+    PRECISION scale_;
+
+    // Upper triangular factor and the rotated right hand side.
+    PRECISION R_[n + 1][n + 1];
+    PRECISION z_[n + 1];
+
+    // Sum of squares of the right hand side orthogonal to the basis of degree n.
+    PRECISION rest_ = 0;
+
+    size_t size_ = 0;
+  };
+}
+#endif
@@ -0,0 +1,239 @@
+// Block of parsed data points, passed from the parsing thread to the fitting one.
+struct CsvBlock {
+  std::vector<double> x;
+  std::vector<double> y;
+  size_t size = 0;
+};
+
+// Bounded queue of parsed blocks. The blocks are allocated once and circulate between the free and
+// the filled queue, so the parser cannot get ahead of the fit by more than the given number of blocks.
+class CsvBlockQueue {
+public:
+  CsvBlockQueue(size_t blocks, size_t block_size) : blocks_(blocks) {
+    for (CsvBlock &block: blocks_) {
+      block.x.resize(block_size);
+      block.y.resize(block_size);
+      free_.push_back(&block);
+    }
+  }
+
+  // Take the empty block to fill, waiting until one is available.
+  CsvBlock *take_free() {
+    return take(free_);
+  }
+
+  // Pass the filled block to the fit, nullptr marks the end of data.
+  void put_filled(CsvBlock *block) {
+    put(filled_, block);
+  }
+
+  // Take the next filled block, waiting until one is available. Returns nullptr at the end of data.
+  CsvBlock *take_filled() {
+    return take(filled_);
+  }
+
+  // Return the block that is no longer needed.
+  void put_free(CsvBlock *block) {
+    block->size = 0;
+    put(free_, block);
+  }
+
+private:
+  CsvBlock *take(std::deque<CsvBlock *> &queue) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&queue]() { return !queue.empty(); });
+    CsvBlock *block = queue.front();
+    queue.pop_front();
+    return block;
+  }
+
+  void put(std::deque<CsvBlock *> &queue, CsvBlock *block) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue.push_back(block);
+    }
+    changed_.notify_all();
+  }
+
+  std::vector<CsvBlock> blocks_;
+  std::deque<CsvBlock *> free_;
+  std::deque<CsvBlock *> filled_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+};
+
+// Parse the field between begin and end as a number, ignoring surrounding blanks and quotes.
+inline bool parse_csv_field(const char *begin, const char *end, double &value) {
+  auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+  while (begin < end && blank(*begin))
+    ++begin;
+  while (end > begin && blank(end[-1]))
+    --end;
+  if (end - begin >= 2 && *begin == '"' && end[-1] == '"') {
+    ++begin;
+    --end;
+  }
+  if (begin < end && *begin == '+')
+    ++begin;
+
+  std::from_chars_result parsed = std::from_chars(begin, end, value);
+  return parsed.ec == std::errc() && parsed.ptr == end && begin < end;
+}
+
+// Find the fields of X and Y in the row between begin and end and parse them. If x_column is negative,
+// X is not parsed.
+inline bool parse_csv_row(const char *begin, const char *end, const CsvOptions &options, double &x, double &y) {
+  bool has_x = options.x_column < 0;
+  bool has_y = false;
+  int column = 0;
+  const char *field = begin;
+  while (!(has_x && has_y)) {
+    const char *field_end = (const char *) memchr(field, options.delimiter, end - field);
+    if (field_end == nullptr)
+      field_end = end;
+    if (column == options.x_column && !parse_csv_field(field, field_end, x))
+      return false;
+    if (column == options.y_column && !parse_csv_field(field, field_end, y))
+      return false;
+    has_x = has_x || column == options.x_column;
+    has_y = has_y || column == options.y_column;
+
+    if (field_end == end)
+      break;
+    field = field_end + 1;
+    column++;
+  }
+  return has_x && has_y;
+}
+
+// Read the delimited text in chunks until the end of the file, passing blocks of parsed X and Y into the queue.
+// Returns false if reading fails. The end of data is put into the queue in any case.
+inline bool parse_csv(std::FILE *file, const CsvOptions &options, CsvBlockQueue &queue, CsvRows &rows) {
+  std::vector<char> buffer(std::max(options.chunk_size, (size_t) 1));
+  size_t kept = 0;              // bytes of the incomplete line at the beginning of the buffer
+  size_t skip = options.skip_lines;
+  bool discarding = false;      // inside the line that is longer than the buffer
+  bool end = false;
+  CsvBlock *block = queue.take_free();
+
+  while (!end) {
+    size_t wanted = buffer.size() - kept;
+    size_t read = fread(buffer.data() + kept, 1, wanted, file);
+    end = read < wanted;
+    if (ferror(file))
+      break;
+
+    const char *at = buffer.data();
+    const char *limit = at + kept + read;
+    while (at < limit) {
+      const char *newline = (const char *) memchr(at, '\n', limit - at);
+      if (newline == nullptr) {
+        // The last line may have no line feed.
+        if (!end)
+          break;
+        newline = limit;
+      }
+
+      if (skip > 0) {
+        skip--;
+      } else if (discarding) {
+        rows.skipped++;
+      } else {
+        double x;
+        double y;
+        const char *line_end = newline;
+        while (line_end > at && (line_end[-1] == '\r' || line_end[-1] == ' ' || line_end[-1] == '\t'))
+          --line_end;
+        if (line_end == at) {
+          // Empty line
+        } else if (parse_csv_row(at, line_end, options, x, y)) {
+          if (options.x_column < 0)
+            x = (double) rows.parsed;
+          block->x[block->size] = x;
+          block->y[block->size] = y;
+          block->size++;
+          rows.parsed++;
+          if (block->size == block->x.size()) {
+            queue.put_filled(block);
+            block = queue.take_free();
+          }
+        } else {
+          rows.skipped++;
+        }
+      }
+      discarding = false;
+      at = newline == limit ? limit : newline + 1;
+    }
+
+    kept = limit - at;
+    if (kept == buffer.size()) {
+      // The line does not fit into the buffer, drop what is read and skip the rest of it.
+      discarding = true;
+      kept = 0;
+    } else {
+      memmove(buffer.data(), at, kept);
+    }
+  }
+
+  bool ok = !ferror(file);
+  if (block->size > 0) {
+    queue.put_filled(block);
+  } else {
+    queue.put_free(block);
+  }
+  queue.put_filled(nullptr);
+  return ok;
+}
+
+// Perform polynomial regression over the delimited text read from the file until its end.
+template<int order, typename TYPE, typename PRECISION>
+bool polynomial_regression_csv(std::FILE *file, Polynomial<order, TYPE, PRECISION> &result,
+                               const CsvOptions &options, CsvRows *rows) {
+  CsvBlockQueue queue(std::max(options.queue_blocks, (size_t) 1), std::max(options.block_size, (size_t) 1));
+  CsvRows counts;
+  bool ok = true;
+  std::thread parser([&]() {
+    ok = parse_csv(file, options, queue, counts);
+  });
+
+  // Blocks are contiguous doubles, so the accumulation is vectorized. Orders solved in closed form are shifted
+  // by the first parsed row, as X is often the time since the epoch, see add_shifted.
+  constexpr bool shifted = order <= 2;
+  RegressionAccumulator<order, TYPE, PRECISION> accumulator;
+  PRECISION x0 = 0;
+  PRECISION y0 = 0;
+  bool first_block = true;
+  while (CsvBlock *block = queue.take_filled()) {
+    if (shifted) {
+      if (first_block) {
+        x0 = (PRECISION) block->x[0];
+        y0 = (PRECISION) block->y[0];
+        first_block = false;
+      }
+      add_shifted(accumulator, block->x.data(), block->y.data(), block->size, x0, y0);
+    } else {
+      accumulator.add(block->x.data(), block->y.data(), block->size);
+    }
+    queue.put_free(block);
+  }
+  parser.join();
+
+  if (rows != nullptr)
+    *rows = counts;
+  if (!ok)
+    return false;
+  result = unshift_polynomial(accumulator.solve(), x0, y0);
+  return true;
+}
+
+// Perform polynomial regression over the delimited text file.
+template<int order, typename TYPE, typename PRECISION>
+bool polynomial_regression_csv(const std::string &path, Polynomial<order, TYPE, PRECISION> &result,
+                               const CsvOptions &options, CsvRows *rows) {
+  std::FILE *file = fopen(path.c_str(), "rb");
+  if (file == nullptr)
+    return false;
+  bool ok = polynomial_regression_csv(file, result, options, rows);
+  fclose(file);
+  return ok;
+}
@@ -0,0 +1,180 @@
+#include <cassert>
+
+template<typename TYPE, typename PRECISION>
+DynamicPolynomial<TYPE, PRECISION>::DynamicPolynomial(int order, int n, bool valid) :
+    coefficients_(order + 1), valid_(valid), data_size_(n) {
+  assert(order >= 0);
+}
+
+template<typename TYPE, typename PRECISION>
+template<int p_order>
+DynamicPolynomial<TYPE, PRECISION>::DynamicPolynomial(const Polynomial<p_order, TYPE, PRECISION> &polynomial) :
+    coefficients_(p_order + 1), valid_(true), residual_(polynomial.residual()), r_squared_(polynomial.r_squared()),
+    data_size_(polynomial.data_size()) {
+  for (int n = 0; n <= p_order; n++) {
+    coefficients_[n] = polynomial[n];
+  }
+}
+
+template<typename TYPE, typename PRECISION>
+void DynamicPolynomial<TYPE, PRECISION>::reset(int order, int n, bool valid) {
+  assert(order >= 0);
+  coefficients_.reset(order + 1);
+  valid_ = valid;
+  residual_ = NAN;
+  r_squared_ = NAN;
+  data_size_ = n;
+}
+
+// Override (), allowing to use polynomial as function that interpolates
+template<typename TYPE, typename PRECISION>
+TYPE DynamicPolynomial<TYPE, PRECISION>::operator()(TYPE x) const {
+  // Horner's scheme
+  int order = this->order();
+  PRECISION s = coefficients_[order];
+  for (int n = order - 1; n >= 0; n--) {
+    s = s * x + coefficients_[n];
+  }
+
+  // If the "official type" happens to be integer or the like, we need a proper rounding.
+  return std::is_integral<TYPE>::value ? (TYPE) std::round((double) s) : (TYPE) s;
+}
+
+template<typename TYPE, typename PRECISION>
+void DynamicPolynomial<TYPE, PRECISION>::evaluate(const TYPE *xs, TYPE *out, size_t count) const {
+  evaluate_horner(coefficients_.data(), (int) coefficients_.size(), xs, out, count);
+}
+
+template<typename TYPE, typename PRECISION>
+void DynamicPolynomial<TYPE, PRECISION>::evaluate_derivative(const TYPE *xs, TYPE *out, size_t count) const {
+  int order = this->order();
+  if (order == 0) {
+    std::fill(out, out + count, (TYPE) 0);
+    return;
+  }
+  // The coefficient n of the derivative is (n + 1) * a[n + 1].
+  const PRECISION *a = coefficients_.data();
+  evaluate_horner_with<PRECISION>([a](int n) { return (PRECISION) (n + 1) * a[n + 1]; }, order, xs, out, count);
+}
+
+template<typename TYPE, typename PRECISION>
+void DynamicPolynomial<TYPE, PRECISION>::evaluate_integral(const TYPE *xs, TYPE *out, size_t count, TYPE C) const {
+  // The coefficient n of the integral is a[n - 1] / n, and C for n = 0.
+  const PRECISION *a = coefficients_.data();
+  evaluate_horner_with<PRECISION>([a, C](int n) { return n == 0 ? (PRECISION) C : a[n - 1] / (PRECISION) n; },
+                                  order() + 2, xs, out, count);
+}
+
+template<typename TYPE, typename PRECISION>
+DynamicPolynomial<TYPE, PRECISION> DynamicPolynomial<TYPE, PRECISION>::differentiate() const {
+  int order = this->order();
+  if (order == 0) {
+    return DynamicPolynomial(0);
+  }
+
+  DynamicPolynomial diff(order - 1);
+  for (int n = 1; n <= order; n++) {
+    diff[n - 1] = n * coefficients_[n];
+  }
+  return diff;
+}
+
+template<typename TYPE, typename PRECISION>
+DynamicPolynomial<TYPE, PRECISION> DynamicPolynomial<TYPE, PRECISION>::integrate(TYPE C) const {
+  int order = this->order();
+  DynamicPolynomial integ(order + 1);
+  for (int n = 1; n <= order + 1; n++) {
+    integ[n] = coefficients_[n - 1] / (PRECISION) n;
+  }
+  integ[0] = C;
+  return integ;
+}
+
+// Define [] to retrieve the coefficients
+template<typename TYPE, typename PRECISION>
+PRECISION &DynamicPolynomial<TYPE, PRECISION>::operator[](int a) {
+  assert(a >= 0 && a <= order());
+  return coefficients_[a];
+}
+
+template<typename TYPE, typename PRECISION>
+const PRECISION &DynamicPolynomial<TYPE, PRECISION>::operator[](int a) const {
+  assert(a >= 0 && a <= order());
+  return coefficients_[a];
+}
+
+// Define the iterators for easy loop
+template<typename TYPE, typename PRECISION>
+PRECISION *DynamicPolynomial<TYPE, PRECISION>::begin() {
+  return coefficients_.begin();
+}
+
+template<typename TYPE, typename PRECISION>
+PRECISION *DynamicPolynomial<TYPE, PRECISION>::end() {
+  return coefficients_.end();
+}
+
+template<typename TYPE, typename PRECISION>
+const PRECISION *DynamicPolynomial<TYPE, PRECISION>::begin() const {
+  return coefficients_.begin();
+}
+
+template<typename TYPE, typename PRECISION>
+const PRECISION *DynamicPolynomial<TYPE, PRECISION>::end() const {
+  return coefficients_.end();
+}
+
+template<typename TYPE, typename PRECISION>
+int DynamicPolynomial<TYPE, PRECISION>::order() const {
+  return (int) coefficients_.size() - 1;
+}
+
+template<typename TYPE, typename PRECISION>
+int DynamicPolynomial<TYPE, PRECISION>::data_size() const {
+  return data_size_;
+}
+
+template<typename TYPE, typename PRECISION>
+PRECISION DynamicPolynomial<TYPE, PRECISION>::residual() const {
+  return residual_;
+}
+
+template<typename TYPE, typename PRECISION>
+void DynamicPolynomial<TYPE, PRECISION>::residual(PRECISION residual) {
+  residual_ = residual;
+}
+
+template<typename TYPE, typename PRECISION>
+PRECISION DynamicPolynomial<TYPE, PRECISION>::avg_sqdif() const {
+  return data_size_ > 0 ? residual_ / data_size_ : NAN;
+}
+
+template<typename TYPE, typename PRECISION>
+PRECISION DynamicPolynomial<TYPE, PRECISION>::r_squared() const {
+  return r_squared_;
+}
+
+template<typename TYPE, typename PRECISION>
+void DynamicPolynomial<TYPE, PRECISION>::r_squared(PRECISION r_squared) {
+  r_squared_ = r_squared;
+}
+
+template<typename TYPE, typename PRECISION>
+std::string DynamicPolynomial<TYPE, PRECISION>::DebugString() const {
+  std::string expression;
+  for (int n = order(); n >= 0; n--) {
+    TYPE k = coefficients_[n];
+    switch (n) {
+      case 0:
+        expression = expression + std::to_string((float) k);
+        break;
+      case 1:
+        expression = expression + std::to_string((float) k) + " * x + ";
+        break;
+      default:
+        expression = expression + std::to_string((float) k) + " * x^" + std::to_string(n) + " + ";
+        break;
+    }
+  }
+  return expression;
+}
@@ -0,0 +1,148 @@
+inline MappedColumn::MappedColumn(MappedColumn &&other) noexcept:
+    data_(std::exchange(other.data_, nullptr)), bytes_(std::exchange(other.bytes_, 0)), type_(other.type_) {
+}
+
+inline MappedColumn &MappedColumn::operator=(MappedColumn &&other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    bytes_ = std::exchange(other.bytes_, 0);
+    type_ = other.type_;
+  }
+  return *this;
+}
+
+inline MappedColumn::~MappedColumn() {
+  close();
+}
+
+inline bool MappedColumn::open(const std::string &path, ColumnType type) {
+  close();
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    int error = errno;
+    ::close(fd);
+    errno = error;
+    return false;
+  }
+  size_t bytes = (size_t) status.st_size;
+  if (bytes % value_size(type) != 0) {
+    ::close(fd);
+    errno = EINVAL;
+    return false;
+  }
+
+  // mmap does not accept the empty mapping, the empty column needs no data.
+  type_ = type;
+  if (bytes == 0) {
+    ::close(fd);
+    return true;
+  }
+
+  void *data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  int error = errno;
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    errno = error;
+    return false;
+  }
+  madvise(data, bytes, MADV_SEQUENTIAL);
+  data_ = (const uint8_t *) data;
+  bytes_ = bytes;
+  return true;
+}
+
+inline void MappedColumn::close() {
+  if (data_ != nullptr)
+    munmap((void *) data_, bytes_);
+  data_ = nullptr;
+  bytes_ = 0;
+}
+
+inline size_t MappedColumn::size() const {
+  return bytes_ / value_size(type_);
+}
+
+inline ColumnType MappedColumn::type() const {
+  return type_;
+}
+
+inline size_t MappedColumn::value_size(ColumnType type) {
+  switch (type) {
+    case ColumnType::FLOAT32:
+      return sizeof(float);
+    case ColumnType::FLOAT64:
+      return sizeof(double);
+    default:
+      return sizeof(uint8_t);
+  }
+}
+
+inline const uint8_t *MappedColumn::data() const {
+  return data_;
+}
+
+// Iterator decoding little-endian values of type T on big-endian hosts.
+template<typename T>
+struct LittleEndianIterator {
+  const uint8_t *at;
+
+  T operator*() const {
+    T value;
+    copy_little_endian((uint8_t *) &value, at, sizeof(T));
+    return value;
+  }
+
+  LittleEndianIterator &operator++() {
+    at += sizeof(T);
+    return *this;
+  }
+};
+
+// Call f(iterator) with the iterator over the values of the column starting from the value from. On little-endian
+// hosts (and for single bytes) this is the pointer into the mapping.
+template<typename FUNCTION>
+auto with_column_iterator(const MappedColumn &column, size_t from, FUNCTION f) {
+  const uint16_t one = 1;
+  const bool little_endian = *(const uint8_t *) &one == 1;
+  const uint8_t *at = column.data() + from * MappedColumn::value_size(column.type());
+  switch (column.type()) {
+    case ColumnType::FLOAT32:
+      return little_endian ? f((const float *) at) : f(LittleEndianIterator<float>{at});
+    case ColumnType::FLOAT64:
+      return little_endian ? f((const double *) at) : f(LittleEndianIterator<double>{at});
+    default:
+      return f((const uint8_t *) at);
+  }
+}
+
+// Perform polynomial regression over count values of mapped X and Y columns starting from the value from.
+template<int order, typename TYPE, typename PRECISION>
+Polynomial<order, TYPE, PRECISION> polynomial_regression_mapped(const MappedColumn &x, const MappedColumn &y,
+                                                                size_t from, size_t count) {
+  assert(x.size() == y.size());
+  assert(from <= y.size());
+  count = std::min(count, y.size() - from);
+
+  // The same path as polynomial_regression, so X far from zero (like timestamps) does not lose precision.
+  return with_column_iterator(x, from, [&](auto x_iter) {
+    return with_column_iterator(y, from, [&](auto y_iter) {
+      return polynomial_regression_iter<order, TYPE, PRECISION>(x_iter, y_iter, true, count);
+    });
+  });
+}
+
+// Perform polynomial regression over count values of mapped Y column starting from the value from.
+template<int order, typename TYPE, typename PRECISION>
+Polynomial<order, TYPE, PRECISION> polynomial_regression_mapped(const MappedColumn &y, size_t from, size_t count) {
+  assert(from <= y.size());
+  count = std::min(count, y.size() - from);
+
+  return with_column_iterator(y, from, [&](auto y_iter) {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(y_iter, true, count);
+  });
+}
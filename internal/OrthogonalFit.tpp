@@ -0,0 +1,86 @@
+template<int n, typename TYPE, typename PRECISION>
+OrthogonalFit<n, TYPE, PRECISION>::OrthogonalFit(const ChebyshevQr<n, PRECISION> &qr) : qr_(qr) {
+}
+
+template<int n, typename TYPE, typename PRECISION>
+PRECISION OrthogonalFit<n, TYPE, PRECISION>::residual(int degree) const {
+  assert(degree >= 0 && degree <= n);
+  return qr_.residual(degree);
+}
+
+template<int n, typename TYPE, typename PRECISION>
+template<int k>
+void OrthogonalFit<n, TYPE, PRECISION>::fill(int degree, Polynomial<k, TYPE, PRECISION> &polynomial) const {
+  PRECISION a[n + 1];
+  qr_.solve(degree, a);
+  for (int i = 0; i <= degree; i++) {
+    polynomial[i] = a[i];
+  }
+
+  // The residual of degree 0 fit is the sum of squared differences between Y and its mean.
+  PRECISION r = qr_.residual(degree);
+  PRECISION total = qr_.residual(0);
+  polynomial.residual(r);
+  polynomial.r_squared(total > 0 ? 1 - r / total : (PRECISION) 1);
+}
+
+template<int n, typename TYPE, typename PRECISION>
+Polynomial<n, TYPE, PRECISION> OrthogonalFit<n, TYPE, PRECISION>::polynomial(int degree) const {
+  assert(degree >= 0 && degree <= n);
+  Polynomial<n, TYPE, PRECISION> polynomial(qr_.size());
+  fill(degree, polynomial);
+  return polynomial;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+template<int k>
+Polynomial<k, TYPE, PRECISION> OrthogonalFit<n, TYPE, PRECISION>::polynomial() const {
+  static_assert(k >= 0 && k <= n);
+  Polynomial<k, TYPE, PRECISION> polynomial(qr_.size());
+  fill(k, polynomial);
+  return polynomial;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+int OrthogonalFit<n, TYPE, PRECISION>::select_degree(DegreeCriterion criterion) const {
+  using std::log;
+  PRECISION N = qr_.size();
+
+  // Degrees above the number of data points minus one cannot be fitted.
+  const int max_degree = (int) std::min<size_t>(qr_.size(), n + 1) - 1;
+  int best = 0;
+  PRECISION best_value = 0;
+  for (int degree = 0; degree <= max_degree; degree++) {
+    PRECISION r = qr_.residual(degree);
+    if (r <= 0) {
+      // Exact fit, cannot be improved.
+      return degree;
+    }
+    PRECISION penalty = criterion == DegreeCriterion::AIC ? 2 : log(N);
+    PRECISION value = N * log(r / N) + penalty * (degree + 1);
+    if (degree == 0 || value < best_value) {
+      best = degree;
+      best_value = value;
+    }
+  }
+  return best;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+int OrthogonalFit<n, TYPE, PRECISION>::select_degree(PRECISION min_relative_drop) const {
+  // Comparing with the highest degree rather than the next one does not stop on odd or even functions,
+  // where every second degree brings no improvement.
+  PRECISION lowest = qr_.residual(n);
+  for (int degree = 0; degree < n; degree++) {
+    PRECISION r = qr_.residual(degree);
+    if (r <= 0 || (r - lowest) / r < min_relative_drop) {
+      return degree;
+    }
+  }
+  return n;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+size_t OrthogonalFit<n, TYPE, PRECISION>::data_size() const {
+  return qr_.size();
+}
@@ -0,0 +1,155 @@
+template<int p_order, typename TYPE, typename PRECISION>
+PiecewisePolynomial<p_order, TYPE, PRECISION>::PiecewisePolynomial(std::vector<PRECISION> knots,
+                                                                   std::vector<PRECISION> coefficients) :
+    knots_(std::move(knots)), coefficients_(std::move(coefficients)) {
+  static_assert(p_order >= 0);
+  assert(knots_.size() >= 2);
+  assert(coefficients_.size() == (knots_.size() - 1) * (p_order + 1));
+
+  // Twice as many cells as segments, so that unevenly spaced knots still mostly have one segment per cell.
+  // Equally spaced knots get exactly one cell per segment.
+  const size_t segment_count = knots_.size() - 1;
+  const PRECISION span = knots_.back() - knots_.front();
+  size_t cells = segment_count;
+  for (size_t s = 1; s < segment_count; ++s) {
+    PRECISION expected = knots_.front() + span * (PRECISION) s / (PRECISION) segment_count;
+    if (std::abs((double) (knots_[s] - expected)) > 1E-9 * std::abs((double) span)) {
+      cells = 2 * segment_count;
+      break;
+    }
+  }
+  cell_scale_ = span > 0 ? (PRECISION) cells / span : (PRECISION) 0;
+
+  cell_first_.assign(cells, segment_count);
+  cell_last_.assign(cells, 0);
+  for (size_t s = 0; s < segment_count; ++s) {
+    // The segment covers [knots_[s], knots_[s + 1][, so it ends in the cell of the last value below the next knot.
+    // cell_of is monotonic, so every x of the segment falls into one of these cells.
+    if (!(knots_[s] < knots_[s + 1]))
+      continue;
+    size_t from = cell_of(knots_[s]);
+    size_t to = cell_of(std::nextafter(knots_[s + 1], knots_[s]));
+    for (size_t cell = from; cell <= to; ++cell) {
+      cell_first_[cell] = std::min(cell_first_[cell], s);
+      cell_last_[cell] = std::max(cell_last_[cell], s);
+    }
+  }
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+size_t PiecewisePolynomial<p_order, TYPE, PRECISION>::cell_of(PRECISION x) const {
+  size_t cell = (size_t) ((x - knots_.front()) * cell_scale_);
+  return std::min(cell, cell_first_.size() - 1);
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+size_t PiecewisePolynomial<p_order, TYPE, PRECISION>::segment_of(TYPE x) const {
+  assert(!knots_.empty());
+  PRECISION v = (PRECISION) x;
+  if (!(v > knots_.front()))
+    return 0;
+  if (v >= knots_.back())
+    return knots_.size() - 2;
+
+  size_t cell = cell_of(v);
+  size_t first = cell_first_[cell];
+  size_t last = cell_last_[cell];
+  if (first >= last)
+    return first;
+
+  // The last segment of the cell that starts at or before x.
+  auto after = std::upper_bound(knots_.begin() + first + 1, knots_.begin() + last + 1, v);
+  return (size_t) (after - knots_.begin()) - 1;
+}
+
+// Override (), allowing to use polynomial as function that interpolates
+template<int p_order, typename TYPE, typename PRECISION>
+TYPE PiecewisePolynomial<p_order, TYPE, PRECISION>::operator()(TYPE x) const {
+  size_t s = segment_of(x);
+  const PRECISION *c = coefficients(s);
+  PRECISION u = (PRECISION) x - knots_[s];
+
+  // Horner's scheme
+  PRECISION v = c[p_order];
+  for (int n = p_order - 1; n >= 0; n--)
+    v = v * u + c[n];
+
+  // If the "official type" happens to be integer or the like, we need a proper rounding.
+  return std::is_integral<TYPE>::value ? (TYPE) std::round((double) v) : (TYPE) v;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void PiecewisePolynomial<p_order, TYPE, PRECISION>::evaluate(const TYPE *xs, TYPE *out, size_t count) const {
+  // Points are processed in blocks. The segments are looked up first, then Horner's scheme runs over
+  // the block with the coefficients gathered per point, so that its loops have no dependencies.
+  constexpr size_t block = 256;
+  const PRECISION *c[block];
+  PRECISION u[block];
+  PRECISION v[block];
+
+  for (size_t from = 0; from < count; from += block) {
+    size_t m = std::min(block, count - from);
+    for (size_t i = 0; i < m; i++) {
+      size_t s = segment_of(xs[from + i]);
+      c[i] = coefficients(s);
+      u[i] = (PRECISION) xs[from + i] - knots_[s];
+      v[i] = c[i][p_order];
+    }
+    for (int n = p_order - 1; n >= 0; n--)
+      for (size_t i = 0; i < m; i++)
+        v[i] = v[i] * u[i] + c[i][n];
+
+    // If the "official type" happens to be integer or the like, we need a proper rounding.
+    if constexpr (std::is_integral<TYPE>::value) {
+      for (size_t i = 0; i < m; i++)
+        out[from + i] = (TYPE) std::round((double) v[i]);
+    } else {
+      for (size_t i = 0; i < m; i++)
+        out[from + i] = (TYPE) v[i];
+    }
+  }
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+size_t PiecewisePolynomial<p_order, TYPE, PRECISION>::ambiguous_cells() const {
+  size_t count = 0;
+  for (size_t cell = 0; cell < cell_first_.size(); ++cell)
+    if (cell_first_[cell] < cell_last_[cell])
+      count++;
+  return count;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+size_t PiecewisePolynomial<p_order, TYPE, PRECISION>::segments() const {
+  return knots_.empty() ? 0 : knots_.size() - 1;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+PRECISION PiecewisePolynomial<p_order, TYPE, PRECISION>::knot(size_t i) const {
+  return knots_.at(i);
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+const PRECISION *PiecewisePolynomial<p_order, TYPE, PRECISION>::coefficients(size_t segment) const {
+  return coefficients_.data() + segment * (p_order + 1);
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+int PiecewisePolynomial<p_order, TYPE, PRECISION>::data_size() const {
+  return data_size_;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void PiecewisePolynomial<p_order, TYPE, PRECISION>::data_size(int n) {
+  data_size_ = n;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+PRECISION PiecewisePolynomial<p_order, TYPE, PRECISION>::residual() const {
+  return residual_;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void PiecewisePolynomial<p_order, TYPE, PRECISION>::residual(PRECISION residual) {
+  residual_ = residual;
+}
@@ -15,12 +15,11 @@ Polynomial<p_order, TYPE, PRECISION>::Polynomial(std::array<PRECISION, p_order +
 
 // Override (), allowing to use polynomial as function that interpolates
 template<int p_order, typename TYPE, typename PRECISION>
-TYPE Polynomial<p_order, TYPE, PRECISION>::operator()(TYPE x) {
-  PRECISION xx = 1;
-  PRECISION s = 0;
-  for (PRECISION a: coefficients_) {
-    s = s + xx * a;
-    xx = xx * x;
+TYPE Polynomial<p_order, TYPE, PRECISION>::operator()(TYPE x) const {
+  // Horner's scheme
+  PRECISION s = coefficients_[p_order];
+  for (int n = p_order - 1; n >= 0; n--) {
+    s = s * x + coefficients_[n];
   }
 
   // If the "official type" happens to be integer or the like, we need a proper rounding.
@@ -28,7 +27,57 @@ TYPE Polynomial<p_order, TYPE, PRECISION>::operator()(TYPE x) {
 }
 
 template<int p_order, typename TYPE, typename PRECISION>
-Polynomial<p_order - 1, TYPE, PRECISION> Polynomial<p_order, TYPE, PRECISION>::differentiate() {
+void Polynomial<p_order, TYPE, PRECISION>::evaluate(const TYPE *xs, TYPE *out, size_t count) const {
+  evaluate_horner(coefficients_.data(), p_order + 1, xs, out, count);
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+template<typename ITERATOR_IN, typename ITERATOR_OUT>
+void Polynomial<p_order, TYPE, PRECISION>::evaluate_iter(ITERATOR_IN first, ITERATOR_IN last, ITERATOR_OUT out) const {
+  // Copy blocks of points into a local buffer, so that any iterators can use the vectorized evaluation.
+  constexpr size_t block = 256;
+  TYPE xs[block];
+  TYPE values[block];
+
+  while (first != last) {
+    size_t m = 0;
+    while (m < block && first != last) {
+      xs[m++] = (TYPE) *first;
+      ++first;
+    }
+    evaluate(xs, values, m);
+    for (size_t i = 0; i < m; i++) {
+      *out = values[i];
+      ++out;
+    }
+  }
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void Polynomial<p_order, TYPE, PRECISION>::evaluate_derivative(const TYPE *xs, TYPE *out, size_t count) const {
+  if constexpr (p_order == 0) {
+    std::fill(out, out + count, (TYPE) 0);
+  } else {
+    std::array<PRECISION, p_order> diff;
+    for (int n = 1; n <= p_order; n++) {
+      diff[n - 1] = n * coefficients_[n];
+    }
+    evaluate_horner(diff.data(), p_order, xs, out, count);
+  }
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void Polynomial<p_order, TYPE, PRECISION>::evaluate_integral(const TYPE *xs, TYPE *out, size_t count, TYPE C) const {
+  std::array<PRECISION, p_order + 2> integ;
+  for (int n = 1; n <= p_order + 1; n++) {
+    integ[n] = coefficients_[n - 1] / (PRECISION) n;
+  }
+  integ[0] = C;
+  evaluate_horner(integ.data(), p_order + 2, xs, out, count);
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+Polynomial<p_order - 1, TYPE, PRECISION> Polynomial<p_order, TYPE, PRECISION>::differentiate() const {
   static_assert(p_order > 0);
   Polynomial<p_order - 1, TYPE, PRECISION> diff;
   for (int n = 1; n <= p_order; n++) {
@@ -38,7 +87,7 @@ Polynomial<p_order - 1, TYPE, PRECISION> Polynomial<p_order, TYPE, PRECISION>::d
 }
 
 template<int p_order, typename TYPE, typename PRECISION>
-Polynomial<p_order + 1, TYPE, PRECISION> Polynomial<p_order, TYPE, PRECISION>::integrate(TYPE C) {
+Polynomial<p_order + 1, TYPE, PRECISION> Polynomial<p_order, TYPE, PRECISION>::integrate(TYPE C) const {
   Polynomial<p_order + 1, TYPE, PRECISION> integ;
   for (int n = 1; n <= p_order + 1; n++) {
     integ[n] = coefficients_[n - 1] / (PRECISION) n;
@@ -53,6 +102,11 @@ PRECISION &Polynomial<p_order, TYPE, PRECISION>::operator[](int a) {
   return coefficients_.at(a);
 }
 
+template<int p_order, typename TYPE, typename PRECISION>
+const PRECISION &Polynomial<p_order, TYPE, PRECISION>::operator[](int a) const {
+  return coefficients_.at(a);
+}
+
 // Define the iterators for easy loop
 template<int p_order, typename TYPE, typename PRECISION>
 typename std::array<PRECISION, p_order>::iterator Polynomial<p_order, TYPE, PRECISION>::begin() {
@@ -84,6 +138,26 @@ void Polynomial<p_order, TYPE, PRECISION>::residual(PRECISION residual) {
   residual_ = residual;
 }
 
+template<int p_order, typename TYPE, typename PRECISION>
+PRECISION Polynomial<p_order, TYPE, PRECISION>::r_squared() const {
+  return r_squared_;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void Polynomial<p_order, TYPE, PRECISION>::r_squared(PRECISION r_squared) {
+  r_squared_ = r_squared;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+int Polynomial<p_order, TYPE, PRECISION>::precision_digits() const {
+  return precision_digits_;
+}
+
+template<int p_order, typename TYPE, typename PRECISION>
+void Polynomial<p_order, TYPE, PRECISION>::precision_digits(int digits) {
+  precision_digits_ = digits;
+}
+
 template<int p_order, typename TYPE, typename PRECISION>
 std::string Polynomial<p_order, TYPE, PRECISION>::DebugString() const {
   std::string expression;
@@ -0,0 +1,157 @@
+#include <cassert>
+
+template<int p_degree, typename TYPE, typename PRECISION>
+Polynomial2D<p_degree, TYPE, PRECISION>::Polynomial2D(int n, bool valid) : valid_(valid), data_size_(n) {
+  static_assert(p_degree >= 0);
+  coefficients_.fill(0);
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+Polynomial2D<p_degree, TYPE, PRECISION>::Polynomial2D(std::array<PRECISION, terms> coefficients, bool valid, int n) :
+    coefficients_(coefficients), valid_(valid), data_size_(n) {
+  static_assert(p_degree >= 0);
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+void Polynomial2D<p_degree, TYPE, PRECISION>::coefficients_of_x(PRECISION y, PRECISION *q) const {
+  // Horner's scheme in y for every degree of x
+  for (int i = 0; i <= p_degree; i++) {
+    const PRECISION *c = coefficients_.data() + index(i, 0);
+    PRECISION s = c[p_degree - i];
+    for (int j = p_degree - i - 1; j >= 0; j--)
+      s = s * y + c[j];
+    q[i] = s;
+  }
+}
+
+// Override (), allowing to use polynomial as function that interpolates
+template<int p_degree, typename TYPE, typename PRECISION>
+TYPE Polynomial2D<p_degree, TYPE, PRECISION>::operator()(TYPE x, TYPE y) const {
+  PRECISION q[p_degree + 1];
+  coefficients_of_x((PRECISION) y, q);
+  PRECISION s = q[p_degree];
+  for (int i = p_degree - 1; i >= 0; i--)
+    s = s * x + q[i];
+
+  // If the "official type" happens to be integer or the like, we need a proper rounding.
+  return std::is_integral<TYPE>::value ? (TYPE) std::round((double) s) : (TYPE) s;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+void Polynomial2D<p_degree, TYPE, PRECISION>::evaluate(const TYPE *xs, const TYPE *ys, TYPE *out,
+                                                        size_t count) const {
+  // Points are processed in blocks, the loops over points in a block have no dependencies and vectorize.
+  constexpr size_t block = 256;
+  PRECISION s[block];
+  PRECISION q[block];
+
+  for (size_t from = 0; from < count; from += block) {
+    size_t m = std::min(block, count - from);
+    const TYPE *x = xs + from;
+    const TYPE *y = ys + from;
+
+    for (size_t k = 0; k < m; k++)
+      s[k] = 0;
+    for (int i = p_degree; i >= 0; i--) {
+      // q = c(i, y), Horner's scheme in y
+      const PRECISION *c = coefficients_.data() + index(i, 0);
+      for (size_t k = 0; k < m; k++)
+        q[k] = c[p_degree - i];
+      for (int j = p_degree - i - 1; j >= 0; j--) {
+        PRECISION cj = c[j];
+        for (size_t k = 0; k < m; k++)
+          q[k] = q[k] * (PRECISION) y[k] + cj;
+      }
+      for (size_t k = 0; k < m; k++)
+        s[k] = s[k] * (PRECISION) x[k] + q[k];
+    }
+
+    // If the "official type" happens to be integer or the like, we need a proper rounding.
+    if constexpr (std::is_integral<TYPE>::value) {
+      for (size_t k = 0; k < m; k++)
+        out[from + k] = (TYPE) std::round((double) s[k]);
+    } else {
+      for (size_t k = 0; k < m; k++)
+        out[from + k] = (TYPE) s[k];
+    }
+  }
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+void Polynomial2D<p_degree, TYPE, PRECISION>::evaluate_grid(const TYPE *xs, size_t nx, const TYPE *ys, size_t ny,
+                                                             TYPE *out) const {
+  PRECISION q[p_degree + 1];
+  for (size_t r = 0; r < ny; r++) {
+    coefficients_of_x((PRECISION) ys[r], q);
+    evaluate_horner(q, p_degree + 1, xs, out + r * nx, nx);
+  }
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+PRECISION &Polynomial2D<p_degree, TYPE, PRECISION>::coefficient(int i, int j) {
+  assert(i >= 0 && j >= 0 && i + j <= p_degree);
+  return coefficients_[index(i, j)];
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+const PRECISION &Polynomial2D<p_degree, TYPE, PRECISION>::coefficient(int i, int j) const {
+  assert(i >= 0 && j >= 0 && i + j <= p_degree);
+  return coefficients_[index(i, j)];
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+PRECISION &Polynomial2D<p_degree, TYPE, PRECISION>::operator[](int a) {
+  return coefficients_.at(a);
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+const PRECISION &Polynomial2D<p_degree, TYPE, PRECISION>::operator[](int a) const {
+  return coefficients_.at(a);
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+int Polynomial2D<p_degree, TYPE, PRECISION>::degree() const {
+  return p_degree;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+int Polynomial2D<p_degree, TYPE, PRECISION>::data_size() const {
+  return data_size_;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+PRECISION Polynomial2D<p_degree, TYPE, PRECISION>::residual() const {
+  return residual_;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+void Polynomial2D<p_degree, TYPE, PRECISION>::residual(PRECISION residual) {
+  residual_ = residual;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+PRECISION Polynomial2D<p_degree, TYPE, PRECISION>::r_squared() const {
+  return r_squared_;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+void Polynomial2D<p_degree, TYPE, PRECISION>::r_squared(PRECISION r_squared) {
+  r_squared_ = r_squared;
+}
+
+template<int p_degree, typename TYPE, typename PRECISION>
+std::string Polynomial2D<p_degree, TYPE, PRECISION>::DebugString() const {
+  std::string expression;
+  for (int i = p_degree; i >= 0; i--) {
+    for (int j = p_degree - i; j >= 0; j--) {
+      if (!expression.empty())
+        expression += " + ";
+      expression += std::to_string((float) coefficients_[index(i, j)]);
+      if (i > 0)
+        expression += i == 1 ? " * x" : " * x^" + std::to_string(i);
+      if (j > 0)
+        expression += j == 1 ? " * y" : " * y^" + std::to_string(j);
+    }
+  }
+  return expression;
+}
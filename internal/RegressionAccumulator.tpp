@@ -0,0 +1,222 @@
+template<int n, typename TYPE, typename PRECISION>
+RegressionAccumulator<n, TYPE, PRECISION>::RegressionAccumulator() {
+  static_assert(n >= 0);
+  clear();
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void RegressionAccumulator<n, TYPE, PRECISION>::add(PRECISION x, PRECISION y) {
+  PRECISION xx = 1;
+  for (int i = 0; i <= n; ++i) {
+    x_sums_[i] += xx;
+    xy_sums_[i] += xx * y;
+    xx = xx * x;
+  }
+  for (int i = n + 1; i <= 2 * n; ++i) {
+    x_sums_[i] += xx;
+    xx = xx * x;
+  }
+  yy_sum_ += y * y;
+  size_++;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+template<typename ITERATOR_X, typename ITERATOR_Y>
+void RegressionAccumulator<n, TYPE, PRECISION>::add(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N) {
+#ifdef POLYNOMIAL_REGRESSION_SIMD
+  if constexpr (is_simd_accumulated<ITERATOR_X, ITERATOR_Y, PRECISION>) {
+    accumulate_sums<n>(x_iter, y_iter, N, x_sums_.data(), xy_sums_.data(), &yy_sum_);
+    size_ += N;
+    return;
+  }
+#endif
+  for (size_t i = 0; i < N; ++i) {
+    add((PRECISION) *x_iter, (PRECISION) *y_iter);
+    ++x_iter;
+    ++y_iter;
+  }
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void RegressionAccumulator<n, TYPE, PRECISION>::remove(PRECISION x, PRECISION y) {
+  assert(size_ > 0);
+  PRECISION xx = 1;
+  for (int i = 0; i <= n; ++i) {
+    x_sums_[i] -= xx;
+    xy_sums_[i] -= xx * y;
+    xx = xx * x;
+  }
+  for (int i = n + 1; i <= 2 * n; ++i) {
+    x_sums_[i] -= xx;
+    xx = xx * x;
+  }
+  yy_sum_ -= y * y;
+  size_--;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void RegressionAccumulator<n, TYPE, PRECISION>::merge(const RegressionAccumulator &other) {
+  for (int i = 0; i <= 2 * n; ++i)
+    x_sums_[i] += other.x_sums_[i];
+  for (int i = 0; i <= n; ++i)
+    xy_sums_[i] += other.xy_sums_[i];
+  yy_sum_ += other.yy_sum_;
+  size_ += other.size_;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void RegressionAccumulator<n, TYPE, PRECISION>::retract(const RegressionAccumulator &other) {
+  assert(size_ >= other.size_);
+  for (int i = 0; i <= 2 * n; ++i)
+    x_sums_[i] -= other.x_sums_[i];
+  for (int i = 0; i <= n; ++i)
+    xy_sums_[i] -= other.xy_sums_[i];
+  yy_sum_ -= other.yy_sum_;
+  size_ -= other.size_;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void RegressionAccumulator<n, TYPE, PRECISION>::shift(PRECISION dx) {
+  // sigma((xi + dx)^k) = sum over j <= k of C(k, j) * dx^(k - j) * sigma(xi^j), the same for the cross sums.
+  // Going from the highest degree down allows to update in place, as the lower sums are still old.
+  std::array<PRECISION, 2 * n + 1> dx_raised;
+  dx_raised[0] = 1;
+  for (int k = 1; k <= 2 * n; ++k)
+    dx_raised[k] = dx_raised[k - 1] * dx;
+
+  for (int k = 2 * n; k > 0; --k) {
+    PRECISION binomial = 1; // C(k, j), starting from j = k
+    PRECISION x_sum = x_sums_[k];
+    PRECISION xy_sum = k <= n ? xy_sums_[k] : 0;
+    for (int j = k - 1; j >= 0; --j) {
+      binomial = binomial * (j + 1) / (k - j);
+      x_sum += binomial * dx_raised[k - j] * x_sums_[j];
+      if (k <= n)
+        xy_sum += binomial * dx_raised[k - j] * xy_sums_[j];
+    }
+    x_sums_[k] = x_sum;
+    if (k <= n)
+      xy_sums_[k] = xy_sum;
+  }
+}
+
+template<int n, typename TYPE, typename PRECISION>
+Polynomial<n, TYPE, PRECISION> RegressionAccumulator<n, TYPE, PRECISION>::solve() const {
+  Polynomial<n, TYPE, PRECISION> a = solve_normal_equations<n, TYPE, PRECISION>(x_sums_.data(), xy_sums_.data(), size_);
+  residual_from_sums(a, x_sums_.data(), xy_sums_.data(), yy_sum_);
+  return a;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+size_t RegressionAccumulator<n, TYPE, PRECISION>::size() const {
+  return size_;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void RegressionAccumulator<n, TYPE, PRECISION>::clear() {
+  x_sums_.fill(0);
+  xy_sums_.fill(0);
+  yy_sum_ = 0;
+  size_ = 0;
+}
+
+// Copy bytes of a value in little-endian order, reversing them on big-endian hosts.
+inline void copy_little_endian(uint8_t *to, const uint8_t *from, size_t size) {
+  const uint16_t one = 1;
+  if (*(const uint8_t *) &one == 1) {
+    memcpy(to, from, size);
+  } else {
+    for (size_t i = 0; i < size; ++i)
+      to[i] = from[size - 1 - i];
+  }
+}
+
+template<int n, typename TYPE, typename PRECISION>
+std::vector<uint8_t> RegressionAccumulator<n, TYPE, PRECISION>::serialize() const {
+  std::vector<uint8_t> data(serialization_header + serialization_values * sizeof(PRECISION));
+  uint8_t *at = data.data();
+
+  memcpy(at, serialization_magic, sizeof(serialization_magic));
+  at += sizeof(serialization_magic);
+  *at++ = serialization_version;
+
+  uint16_t order = n;
+  copy_little_endian(at, (const uint8_t *) &order, sizeof(order));
+  at += sizeof(order);
+  *at++ = sizeof(PRECISION);
+
+  uint64_t size = size_;
+  copy_little_endian(at, (const uint8_t *) &size, sizeof(size));
+  at += sizeof(size);
+
+  // Only the bytes of the value are copied, the padding of x87 long double is written as zeros.
+  auto write = [&at](const PRECISION &value) {
+    uint8_t bytes[sizeof(PRECISION)] = {};
+    memcpy(bytes, &value, serialization_value_bytes);
+    copy_little_endian(at, bytes, sizeof(PRECISION));
+    at += sizeof(PRECISION);
+  };
+  for (const PRECISION &value: x_sums_)
+    write(value);
+  for (const PRECISION &value: xy_sums_)
+    write(value);
+  write(yy_sum_);
+
+  return data;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+bool RegressionAccumulator<n, TYPE, PRECISION>::deserialize(const uint8_t *data, size_t size) {
+  if (size != serialization_header + serialization_values * sizeof(PRECISION))
+    return false;
+
+  const uint8_t *at = data;
+  if (memcmp(at, serialization_magic, sizeof(serialization_magic)) != 0)
+    return false;
+  at += sizeof(serialization_magic);
+  if (*at++ != serialization_version)
+    return false;
+
+  uint16_t order;
+  copy_little_endian((uint8_t *) &order, at, sizeof(order));
+  at += sizeof(order);
+  if (order != n || *at++ != sizeof(PRECISION))
+    return false;
+
+  uint64_t count;
+  copy_little_endian((uint8_t *) &count, at, sizeof(count));
+  at += sizeof(count);
+
+  auto read = [&at](PRECISION &value) {
+    copy_little_endian((uint8_t *) &value, at, sizeof(PRECISION));
+    at += sizeof(PRECISION);
+  };
+  for (PRECISION &value: x_sums_)
+    read(value);
+  for (PRECISION &value: xy_sums_)
+    read(value);
+  read(yy_sum_);
+  size_ = count;
+
+  return true;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+bool RegressionAccumulator<n, TYPE, PRECISION>::deserialize(const std::vector<uint8_t> &data) {
+  return deserialize(data.data(), data.size());
+}
+
+template<int n, typename TYPE, typename PRECISION>
+const std::array<PRECISION, 2 * n + 1> &RegressionAccumulator<n, TYPE, PRECISION>::x_sums() const {
+  return x_sums_;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+const std::array<PRECISION, n + 1> &RegressionAccumulator<n, TYPE, PRECISION>::xy_sums() const {
+  return xy_sums_;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+PRECISION RegressionAccumulator<n, TYPE, PRECISION>::yy_sum() const {
+  return yy_sum_;
+}
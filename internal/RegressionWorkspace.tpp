@@ -0,0 +1,53 @@
+#include <cassert>
+
+template<typename PRECISION>
+RegressionWorkspace<PRECISION>::RegressionWorkspace(std::pmr::memory_resource *resource) :
+    x_sums_(resource), xy_sums_(resource), yy_sums_(resource), matrix_(resource), permutation_(resource) {
+}
+
+template<typename PRECISION>
+void RegressionWorkspace<PRECISION>::reserve(int order, size_t series) {
+  assert(order >= 0);
+  size_t np1 = order + 1;
+  x_sums_.reserve(2 * np1 - 1);
+  xy_sums_.reserve(np1 * series);
+  yy_sums_.reserve(series);
+  matrix_.reserve(np1 * np1);
+  permutation_.reserve(np1);
+}
+
+// assign() does not reallocate if the capacity is sufficient.
+template<typename PRECISION>
+PRECISION *RegressionWorkspace<PRECISION>::x_sums(int order) {
+  x_sums_.assign(2 * order + 1, 0);
+  return x_sums_.data();
+}
+
+template<typename PRECISION>
+PRECISION *RegressionWorkspace<PRECISION>::xy_sums(int order, size_t series) {
+  xy_sums_.assign((order + 1) * series, 0);
+  return xy_sums_.data();
+}
+
+template<typename PRECISION>
+PRECISION *RegressionWorkspace<PRECISION>::yy_sums(size_t series) {
+  yy_sums_.assign(series, 0);
+  return yy_sums_.data();
+}
+
+template<typename PRECISION>
+PRECISION *RegressionWorkspace<PRECISION>::matrix(int order) {
+  matrix_.assign((order + 1) * (order + 1), 0);
+  return matrix_.data();
+}
+
+template<typename PRECISION>
+int *RegressionWorkspace<PRECISION>::permutation(int order) {
+  permutation_.assign(order + 1, 0);
+  return permutation_.data();
+}
+
+template<typename PRECISION>
+std::pmr::memory_resource *RegressionWorkspace<PRECISION>::resource() const {
+  return x_sums_.get_allocator().resource();
+}
@@ -0,0 +1,116 @@
+template<int n, int window, typename TYPE, typename PRECISION>
+SavitzkyGolayFilter<n, window, TYPE, PRECISION>::SavitzkyGolayFilter(int derivative, PRECISION spacing) :
+    kernels_((size_t) window * window, 0), derivative_(derivative) {
+  static_assert(n >= 0);
+  static_assert(window > n, "The window must have more samples than the order of the polynomial");
+  assert(derivative >= 0);
+  assert(spacing > 0);
+
+  // The coefficients of the fit are a[k] = sigma(weight(i, k) * yi), and the derivative d at the position p is
+  // sigma(a[k] * k! / (k - d)! * p^(k - d)) over k >= d, divided by spacing^d.
+  const FixedProjection<n, window, PRECISION> projection;
+  PRECISION scale = 1;
+  for (int d = 0; d < derivative; ++d)
+    scale /= spacing;
+
+  for (int p = 0; p < window; ++p) {
+    // factor[k] = k! / (k - d)! * p^(k - d) * scale
+    PRECISION factor[n + 1] = {};
+    for (int k = derivative; k <= n; ++k) {
+      PRECISION f = scale;
+      for (int j = k - derivative + 1; j <= k; ++j)
+        f *= (PRECISION) j;
+      for (int j = 0; j < k - derivative; ++j)
+        f *= (PRECISION) p;
+      factor[k] = f;
+    }
+
+    PRECISION *kernel = kernels_.data() + (size_t) p * window;
+    for (int i = 0; i < window; ++i) {
+      PRECISION w = 0;
+      for (int k = derivative; k <= n; ++k)
+        w += projection.weight(i, k) * factor[k];
+      kernel[i] = w;
+    }
+  }
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+void SavitzkyGolayFilter<n, window, TYPE, PRECISION>::apply(const TYPE *in, TYPE *out, size_t count) const {
+  assert(count >= (size_t) window);
+  constexpr size_t half = window / 2;
+
+  // The edges evaluate the polynomial of the first or the last window at the position of the sample.
+  for (size_t j = 0; j < half; ++j)
+    out[j] = round(dot(kernel((int) j), in));
+  const TYPE *last = in + count - window;
+  for (size_t j = count - window + half + 1; j < count; ++j)
+    out[j] = round(dot(kernel((int) (j - (count - window))), last));
+
+  convolve(in, out, half, count - window + half + 1);
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+template<typename COLLECTION_Y>
+std::vector<TYPE> SavitzkyGolayFilter<n, window, TYPE, PRECISION>::apply(const COLLECTION_Y &y) const {
+  std::vector<TYPE> out(y.size());
+  if constexpr (is_contiguous_collection<COLLECTION_Y>::value &&
+                std::is_same<typename COLLECTION_Y::value_type, TYPE>::value) {
+    apply(y.data(), out.data(), y.size());
+  } else {
+    std::vector<TYPE> in(y.cbegin(), y.cend());
+    apply(in.data(), out.data(), in.size());
+  }
+  return out;
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+void SavitzkyGolayFilter<n, window, TYPE, PRECISION>::convolve(const TYPE *in, TYPE *out, size_t from,
+                                                               size_t to) const {
+  // Outputs are computed in blocks, adding one weighted tap at a time to all outputs of the block. The loop over
+  // the block has no dependencies and vectorizes, and the input of the block stays in the cache across the taps.
+  constexpr size_t block = 512;
+  constexpr size_t half = window / 2;
+  const PRECISION *h = kernel((int) half);
+  PRECISION sum[block];
+
+  for (size_t first = from; first < to; first += block) {
+    size_t m = std::min(block, to - first);
+    const TYPE *x = in + first - half;
+    for (size_t k = 0; k < m; k++)
+      sum[k] = 0;
+    for (int i = 0; i < window; ++i) {
+      PRECISION w = h[i];
+      const TYPE *xi = x + i;
+      for (size_t k = 0; k < m; k++)
+        sum[k] += w * (PRECISION) xi[k];
+    }
+    for (size_t k = 0; k < m; k++)
+      out[first + k] = round(sum[k]);
+  }
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+PRECISION SavitzkyGolayFilter<n, window, TYPE, PRECISION>::dot(const PRECISION *kernel, const TYPE *in) {
+  PRECISION sum = 0;
+  for (int i = 0; i < window; ++i)
+    sum += kernel[i] * (PRECISION) in[i];
+  return sum;
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+TYPE SavitzkyGolayFilter<n, window, TYPE, PRECISION>::round(PRECISION v) {
+  // If the "official type" happens to be integer or the like, we need a proper rounding.
+  return std::is_integral<TYPE>::value ? (TYPE) std::round((double) v) : (TYPE) v;
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+const PRECISION *SavitzkyGolayFilter<n, window, TYPE, PRECISION>::kernel(int position) const {
+  assert(position >= 0 && position < window);
+  return kernels_.data() + (size_t) position * window;
+}
+
+template<int n, int window, typename TYPE, typename PRECISION>
+int SavitzkyGolayFilter<n, window, TYPE, PRECISION>::derivative() const {
+  return derivative_;
+}
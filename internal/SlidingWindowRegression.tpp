@@ -0,0 +1,124 @@
+template<int n, typename TYPE, typename PRECISION>
+SlidingWindowRegression<n, TYPE, PRECISION>::SlidingWindowRegression(size_t window) : window_(window) {
+  assert(window > 0);
+  x_.reserve(window);
+  y_.reserve(window);
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void SlidingWindowRegression<n, TYPE, PRECISION>::add(PRECISION x, PRECISION y) {
+  assert(!enumerated_ || y_.empty());
+  enumerated_ = false;
+
+  if (y_.size() < window_) {
+    x_.push_back(x);
+    y_.push_back(y);
+  } else {
+    accumulator_.remove(x_[oldest_], y_[oldest_]);
+    x_[oldest_] = x;
+    y_[oldest_] = y;
+    oldest_ = (oldest_ + 1) % window_;
+  }
+  accumulator_.add(x, y);
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void SlidingWindowRegression<n, TYPE, PRECISION>::add(PRECISION y) {
+  assert(enumerated_ || y_.empty());
+  enumerated_ = true;
+
+  if (y_.size() < window_) {
+    y_.push_back(y);
+  } else {
+    // The oldest point is at x = 0 and only contributes to sigma(yi). After removing it, move the origin so that
+    // the next oldest is at x = 0: sigma((xi - 1)^k * yi) = sigma(C(k, j) * (-1)^(k - j) * sigma(xi^j * yi)).
+    PRECISION oldest = y_[oldest_];
+    y_sums_[0] -= oldest;
+    yy_sum_ -= oldest * oldest;
+    for (int k = n; k >= 1; --k) {
+      PRECISION sum = y_sums_[k];
+      PRECISION binomial = 1; // C(k, j)
+      for (int j = k - 1; j >= 0; --j) {
+        binomial = binomial * (j + 1) / (k - j);
+        sum += ((k - j) % 2 == 0 ? binomial : -binomial) * y_sums_[j];
+      }
+      y_sums_[k] = sum;
+    }
+    y_[oldest_] = y;
+    oldest_ = (oldest_ + 1) % window_;
+  }
+
+  PRECISION x = (PRECISION) (y_.size() - 1);
+  PRECISION xx = 1;
+  for (int k = 0; k <= n; ++k) {
+    y_sums_[k] += xx * y;
+    xx = xx * x;
+  }
+  yy_sum_ += y * y;
+
+  // Moving the origin accumulates the rounding error, so the sums are recomputed once per window.
+  if (++steps_ >= window_)
+    rebuild();
+}
+
+template<int n, typename TYPE, typename PRECISION>
+Polynomial<n, TYPE, PRECISION> SlidingWindowRegression<n, TYPE, PRECISION>::solve() const {
+  if (!enumerated_)
+    return accumulator_.solve();
+
+  // X = sigma(xi^k) is exact for X enumerating 0 to N - 1.
+  size_t N = y_.size();
+  PRECISION X[2 * n + 1];
+  enumerated_power_sums<2 * n>(N, X);
+  Polynomial<n, TYPE, PRECISION> a = solve_normal_equations<n, TYPE, PRECISION>(X, y_sums_.data(), N);
+  residual_from_sums(a, X, y_sums_.data(), yy_sum_);
+  return a;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void SlidingWindowRegression<n, TYPE, PRECISION>::rebuild() {
+  size_t N = y_.size();
+  if (enumerated_) {
+    y_sums_.fill(0);
+    yy_sum_ = 0;
+    steps_ = 0;
+    for (size_t i = 0; i < N; i++) {
+      PRECISION y = y_[(oldest_ + i) % N];
+      PRECISION xx = 1;
+      for (int k = 0; k <= n; ++k) {
+        y_sums_[k] += xx * y;
+        xx = xx * (PRECISION) i;
+      }
+      yy_sum_ += y * y;
+    }
+    return;
+  }
+
+  accumulator_.clear();
+  for (size_t i = 0; i < N; i++) {
+    size_t at = (oldest_ + i) % N;
+    accumulator_.add(x_[at], y_[at]);
+  }
+}
+
+template<int n, typename TYPE, typename PRECISION>
+size_t SlidingWindowRegression<n, TYPE, PRECISION>::size() const {
+  return y_.size();
+}
+
+template<int n, typename TYPE, typename PRECISION>
+size_t SlidingWindowRegression<n, TYPE, PRECISION>::window() const {
+  return window_;
+}
+
+template<int n, typename TYPE, typename PRECISION>
+void SlidingWindowRegression<n, TYPE, PRECISION>::clear() {
+  accumulator_.clear();
+  x_.clear();
+  y_.clear();
+  y_sums_.fill(0);
+  yy_sum_ = 0;
+  steps_ = 0;
+  oldest_ = 0;
+  enumerated_ = false;
+}
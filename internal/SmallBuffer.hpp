@@ -0,0 +1,114 @@
+#ifndef _POLYNOMIAL_REGRESSION_ABC_SMALL_BUFFER_H
+#define _POLYNOMIAL_REGRESSION_ABC_SMALL_BUFFER_H  __POLYNOMIAL_REGRESSION_ABC_SMALL_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace andviane {
+
+// Fixed size array of runtime length that keeps up to inline_capacity values inside the object
+// and only allocates on the heap if more are needed. Values are zero initialized.
+  template<typename T, size_t inline_capacity>
+  class SmallBuffer {
+  public:
+    explicit SmallBuffer(size_t size = 0) : inline_{}, size_(size), capacity_(0) {
+      if (size_ > inline_capacity) {
+        heap_.reset(new T[size_]());
+        capacity_ = size_;
+      }
+    }
+
+    SmallBuffer(const SmallBuffer &other) : SmallBuffer(other.size_) {
+      std::copy(other.begin(), other.end(), begin());
+    }
+
+    SmallBuffer(SmallBuffer &&other) noexcept: inline_{}, heap_(std::move(other.heap_)), size_(other.size_),
+                                                capacity_(other.capacity_) {
+      if (!heap_)
+        std::copy(other.inline_, other.inline_ + size_, inline_);
+      other.size_ = 0;
+      other.capacity_ = 0;
+    }
+
+    SmallBuffer &operator=(const SmallBuffer &other) {
+      if (this != &other) {
+        SmallBuffer copy(other);
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+
+    SmallBuffer &operator=(SmallBuffer &&other) noexcept {
+      if (this != &other) {
+        heap_ = std::move(other.heap_);
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        if (!heap_)
+          std::copy(other.inline_, other.inline_ + size_, inline_);
+        other.size_ = 0;
+        other.capacity_ = 0;
+      }
+      return *this;
+    }
+
+    // Change the size and set all values to zero. The heap storage is kept and reused if it is large enough.
+    void reset(size_t size) {
+      if (size > inline_capacity && size > capacity_) {
+        heap_.reset(new T[size]());
+        capacity_ = size;
+      }
+      size_ = size;
+      std::fill(begin(), end(), T());
+    }
+
+    T *data() {
+      return heap_ ? heap_.get() : inline_;
+    }
+
+    const T *data() const {
+      return heap_ ? heap_.get() : inline_;
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    // True if the values are stored on the heap.
+    bool allocated() const {
+      return (bool) heap_;
+    }
+
+    T &operator[](size_t i) {
+      return data()[i];
+    }
+
+    const T &operator[](size_t i) const {
+      return data()[i];
+    }
+
+    T *begin() {
+      return data();
+    }
+
+    T *end() {
+      return data() + size_;
+    }
+
+    const T *begin() const {
+      return data();
+    }
+
+    const T *end() const {
+      return data() + size_;
+    }
+
+  private:
+    T inline_[inline_capacity];
+    std::unique_ptr<T[]> heap_;
+    size_t size_;
+    size_t capacity_; // Of the heap storage
+  };
+}
+
+#endif //_POLYNOMIAL_REGRESSION_ABC_SMALL_BUFFER_H
@@ -47,140 +47,446 @@
 #include <cmath>
 #include <cassert>
 #include <array>
+#include <type_traits>
+#include <utility>
 #include <string.h>
+#include <thread>
+#include <chrono>
+#include <limits>
+
+#include "../Polynomial.hpp"
+#include "../DynamicPolynomial.hpp"
+#include "regression_kernels.hpp"
+#include "SmallBuffer.hpp"
+#include "../RegressionWorkspace.hpp"
+#include "../FitStats.hpp"
 
 namespace andviane {
 
-// Build the matrix of X values raised in degree.
-  template<int till_degree, typename PRECISION, typename ITERATOR_X>
-  static void build_x_matrix(ITERATOR_X x_iter, size_t N, std::array<std::vector<PRECISION>, till_degree> &x_raised) {
-    for (int degree = 0; degree < till_degree; degree++) {
-      switch (degree) {
-        case 0:
-          x_raised[degree] = std::vector<PRECISION>(N, 1); // x^0
-          break;
-        case 1:
-          x_raised[degree] = std::vector<PRECISION>(N);   // x^1
-          for (int ix = 0; ix < N; ix++) {
-            x_raised[degree][ix] = (PRECISION) *x_iter;
-            ++x_iter;
-          }
-          break;
-        default:
-          x_raised[degree] = std::vector<PRECISION>(N);   // x^degree
-          for (int ix = 0; ix < N; ix++)
-            x_raised[degree][ix] = x_raised[degree - 1][ix] * x_raised[1][ix];
-          break;
-      }
+// True if the collection stores its values contiguously, providing data().
+  template<typename COLLECTION, typename = void>
+  struct is_contiguous_collection : std::false_type {
+  };
+
+  template<typename COLLECTION>
+  struct is_contiguous_collection<COLLECTION, std::void_t<decltype(std::declval<const COLLECTION &>().data())>>
+      : std::true_type {
+  };
+
+// Call f(chunk) for every chunk in 0 .. chunks - 1, using the given number of threads.
+// The thread t processes the chunks t, t + threads, t + 2 * threads and so on.
+  template<typename FUNCTION>
+  void parallel_for_chunks(size_t chunks, unsigned threads, FUNCTION f) {
+    if (threads <= 1 || chunks <= 1) {
+      for (size_t chunk = 0; chunk < chunks; ++chunk)
+        f(chunk);
+      return;
     }
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads && t < chunks; ++t) {
+      workers.emplace_back([t, threads, chunks, &f]() {
+        for (size_t chunk = t; chunk < chunks; chunk += threads)
+          f(chunk);
+      });
+    }
+    for (auto &worker: workers)
+      worker.join();
   }
 
-// Build the fixed (enumerating) matrix of X values raised in degree.
+// Sums of x raised in degree for X enumerating 0 to N - 1, S[k] = sigma(i^k) for k = 0 .. till_degree.
+// Uses N^(k + 1) = sigma(C(k + 1, j) * S[j]) over j = 0 .. k, so it costs O(n^2) regardless of N.
   template<int till_degree, typename PRECISION>
-  static void build_x_matrix(size_t N, std::array<std::vector<PRECISION>, till_degree> &x_raised) {
-    for (int degree = 0; degree < till_degree; degree++) {
-      switch (degree) {
-        case 0:
-          x_raised[degree] = std::vector<PRECISION>(N, 1); // x^0
-          break;
-        case 1:
-          x_raised[degree] = std::vector<PRECISION>(N);   // x^1
-          for (int ix = 0; ix < N; ix++) {
-            x_raised[degree][ix] = (PRECISION) ix;
-          }
-          break;
-        default:
-          x_raised[degree] = std::vector<PRECISION>(N);   // x^degree
-          for (int ix = 0; ix < N; ix++)
-            x_raised[degree][ix] = x_raised[degree - 1][ix] * x_raised[1][ix];
-          break;
+  constexpr void enumerated_power_sums(size_t N, PRECISION *S) {
+    PRECISION N_raised = (PRECISION) N; // N^(k + 1)
+    for (int k = 0; k <= till_degree; ++k) {
+      PRECISION s = N_raised;
+      PRECISION binomial = 1; // C(k + 1, j)
+      for (int j = 0; j < k; ++j) {
+        s -= binomial * S[j];
+        binomial = binomial * (k + 1 - j) / (j + 1);
       }
+      S[k] = s / (k + 1);
+      N_raised = N_raised * (PRECISION) N;
     }
   }
 
-// Main algorithm of polynomial regression
-  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_Y>
-  Polynomial <n, TYPE, PRECISION> polynomial_regression_iter(const std::array<std::vector<PRECISION>, 2 * n + 1> &x_raised,
-                                                        ITERATOR_Y y_iter,
-                                                        bool compute_residual, size_t N) {
-    constexpr int np1 = n + 1;
-    constexpr int np2 = n + 2;
-    constexpr int tnp1 = 2 * n + 1;
+// LU factorization of the normal matrix of polynomial regression. Once factorized, it can be used to
+// solve for many right hand sides (different Y against the same X) without repeating the elimination.
+  template<int n, typename PRECISION>
+  class NormalFactorization {
+  public:
+    // Factorize the normal matrix built from X = sigma(xi^k) for k = 0 .. 2n
+    constexpr explicit NormalFactorization(const PRECISION *X) : B_{}, permutation_{} {
+      normal_factorize(n, X, B_, permutation_);
+    }
 
-    // X = vector that stores values of sigma(xi^2n)
-    PRECISION X[tnp1];
-    for (int i = 0; i < tnp1; ++i) {
-      X[i] = 0;
-      for (int j = 0; j < N; ++j)
-        X[i] += x_raised[i][j];
+    // Solve for the right hand side Y = sigma(xi^k * yi) for k = 0 .. n, writing the coefficients into a.
+    constexpr void solve(const PRECISION *Y, PRECISION *a) const {
+      normal_solve(n, B_, permutation_, Y, a);
     }
 
-    // a = vector to store final coefficients.
-    Polynomial<n, TYPE, PRECISION> a(N);
+    // Solve for the right hand side Y, obtaining the polynomial. N is the number of data points.
+    template<typename TYPE>
+    Polynomial<n, TYPE, PRECISION> solve(const PRECISION *Y, size_t N) const {
+      std::array<PRECISION, n + 1> a;
+      solve(Y, a.data());
+      return Polynomial<n, TYPE, PRECISION>(a, true, N);
+    }
 
-    // B = normal augmented matrix that stores the equations.
-    PRECISION B[np1][np2];
-    memset(&B, 0, sizeof(B));
+  private:
+    // Upper triangle holds the eliminated matrix, below the diagonal are the multipliers. Row major.
+    PRECISION B_[(n + 1) * (n + 1)];
+    int permutation_[n + 1];
+  };
 
-    for (int i = 0; i <= n; ++i)
-      for (int j = 0; j <= n; ++j)
-        B[i][j] = X[i + j];
-
-    // Y = vector to store values of sigma(xi^n * yi)
-    PRECISION Y[np1];
-    for (int i = 0; i < np1; ++i) {
-      Y[i] = 0;
-      ITERATOR_Y y_iter_iter = y_iter;
-      for (int j = 0; j < N; ++j) {
-        Y[i] += x_raised[i][j] * (*y_iter_iter++);
+// Solve the normal equations of order 0, 1 or 2 in closed form, writing the coefficients into a.
+// X = sigma(xi^k) for k = 0 .. 2n, Y = sigma(xi^k * yi) for k = 0 .. n. The sums are moved to the mean of X
+// before solving, and the solution is moved back. This centers the raw sums after they were accumulated, so it
+// cannot recover the precision they lost if X is far from zero: the callers that care accumulate the sums
+// relative to a data point (add_shifted) or keep the centered sums (centered_regression_iter).
+  template<int n, typename PRECISION>
+  constexpr void solve_low_order(const PRECISION *X, const PRECISION *Y, PRECISION *a) {
+    static_assert(n >= 0 && n <= 2);
+    const PRECISION N = X[0];
+    if constexpr (n == 0) {
+      a[0] = Y[0] / N;
+    } else {
+      // U2 = sigma((xi - m)^2), T1 = sigma((xi - m) * yi) where m is the mean of X.
+      const PRECISION m = X[1] / N;
+      const PRECISION U2 = X[2] - m * X[1];
+      const PRECISION T1 = Y[1] - m * Y[0];
+      if constexpr (n == 1) {
+        a[1] = T1 / U2;
+        a[0] = (Y[0] - a[1] * X[1]) / N;
+      } else {
+        // U3, U4 = sigma((xi - m)^3), sigma((xi - m)^4), T2 = sigma((xi - m)^2 * yi). As sigma(xi - m) = 0,
+        // the constant term c0 = (Y[0] - U2 * c2) / N of y = c0 + c1 * (x - m) + c2 * (x - m)^2 is eliminated,
+        // leaving 2 x 2 system for c1 and c2.
+        const PRECISION mm = m * m;
+        const PRECISION U3 = X[3] - 3 * m * X[2] + 2 * mm * X[1];
+        const PRECISION U4 = X[4] - 4 * m * X[3] + 6 * mm * X[2] - 3 * mm * m * X[1];
+        const PRECISION T2 = Y[2] - 2 * m * Y[1] + mm * Y[0];
+
+        const PRECISION D = U4 - U2 * U2 / N;
+        const PRECISION R = T2 - U2 * Y[0] / N;
+        const PRECISION det = U2 * D - U3 * U3;
+        const PRECISION c1 = (T1 * D - U3 * R) / det;
+        const PRECISION c2 = (U2 * R - U3 * T1) / det;
+        const PRECISION c0 = (Y[0] - U2 * c2) / N;
+
+        a[2] = c2;
+        a[1] = c1 - 2 * c2 * m;
+        a[0] = c0 - c1 * m + c2 * mm;
       }
     }
+  }
+
+// Solve the factorized normal equations, or use the closed form if the order is 2 or less.
+// B and permutation are the result of normal_factorize.
+  template<int n, typename PRECISION>
+  void solve_coefficients(const PRECISION *X, const PRECISION *Y, const PRECISION *B, const int *permutation,
+                          PRECISION *a) {
+    if constexpr (n <= 2) {
+      solve_low_order<n>(X, Y, a);
+    } else {
+      normal_solve(n, B, permutation, Y, a);
+    }
+  }
+
+// Solve the normal equations of polynomial regression. Orders up to 2 are solved in closed form.
+// X = sigma(xi^k) for k = 0 .. 2n, Y = sigma(xi^k * yi) for k = 0 .. n, N = number of data points.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE>
+  Polynomial <n, TYPE, PRECISION> solve_normal_equations(const PRECISION *X, const PRECISION *Y, size_t N) {
+    if constexpr (n <= 2) {
+      std::array<PRECISION, n + 1> a;
+      solve_low_order<n>(X, Y, a.data());
+      return Polynomial<n, TYPE, PRECISION>(a, true, N);
+    } else {
+      return NormalFactorization<n, PRECISION>(X).template solve<TYPE>(Y, N);
+    }
+  }
 
-    // Load values of Y as last column of B
+// Solve the normal equations of polynomial regression of the order n given at runtime, writing the result into a.
+// X = sigma(xi^k) for k = 0 .. 2n, Y = sigma(xi^k * yi) for k = 0 .. n, N = number of data points.
+// B and permutation are scratch buffers of (n + 1) * (n + 1) and n + 1 values.
+  template<typename TYPE, typename PRECISION>
+  void solve_normal_equations_dynamic(int n, const PRECISION *X, const PRECISION *Y, size_t N,
+                                      PRECISION *B, int *permutation, DynamicPolynomial<TYPE, PRECISION> &a) {
+    normal_factorize(n, X, B, permutation);
+    a.reset(n, N);
+    normal_solve(n, B, permutation, Y, a.begin());
+  }
+
+// Evaluate the polynomial at x in its internal precision, without rounding to TYPE.
+  template<int n, typename TYPE, typename PRECISION>
+  PRECISION evaluate_precise(const Polynomial<n, TYPE, PRECISION> &a, PRECISION x) {
+    PRECISION s = a[n];
+    for (int k = n - 1; k >= 0; k--)
+      s = s * x + a[k];
+    return s;
+  }
+
+// Compute the residual and R^2 from the sums, without any pass over the data. X = sigma(xi^k) for k = 0 .. 2n,
+// Y = sigma(xi^k * yi) for k = 0 .. n, YY = sigma(yi^2). The residual is expanded as
+// sigma((a(xi) - yi)^2) = a.G.a - 2 * a.Y + YY where G[i][j] = X[i + j].
+  template<int n, typename TYPE, typename PRECISION>
+  void residual_from_sums(Polynomial<n, TYPE, PRECISION> &a, const PRECISION *X, const PRECISION *Y, PRECISION YY) {
+    PRECISION coefficients[n + 1];
     for (int i = 0; i <= n; ++i)
-      B[i][np1] = Y[i];
-
-    // Pivotisation of the B matrix.
-    for (int i = 0; i < np1; ++i)
-      for (int k = i + 1; k < np1; ++k)
-        if (B[i][i] < B[k][i])
-          for (int j = 0; j <= np1; ++j) {
-            std::swap(B[i][j], B[k][j]);
-          }
-
-    // Performs the Gaussian elimination.
-    // (1) Make all elements below the pivot equals to zero
-    //     or eliminate the variable.
-    for (int i = 0; i < n; ++i)
-      for (int k = i + 1; k < np1; ++k) {
-        PRECISION t = B[k][i] / B[i][i];
-        for (int j = 0; j <= np1; ++j)
-          B[k][j] -= t * B[i][j];         // (1)
+      coefficients[i] = a[i];
+
+    PRECISION r;
+    PRECISION r_squared;
+    residual_from_sums(n, coefficients, X, Y, YY, r, r_squared);
+    a.residual(r);
+    a.r_squared(r_squared);
+  }
+
+// Find the minimal absolute pivot and the condition number (1-norm) of the factorized normal matrix.
+// X = sigma(xi^k) for k = 0 .. 2n, B and permutation are the result of normal_factorize.
+  template<typename PRECISION>
+  void normal_conditioning(int n, const PRECISION *X, const PRECISION *B, const int *permutation,
+                           PRECISION &min_pivot, PRECISION &condition) {
+    const int np1 = n + 1;
+    auto abs_value = [](PRECISION v) { return v < 0 ? -v : v; };
+
+    // Pivots are on the diagonal of the eliminated matrix.
+    min_pivot = abs_value(B[0]);
+    for (int i = 1; i <= n; ++i)
+      min_pivot = std::min(min_pivot, abs_value(B[i * np1 + i]));
+
+    // 1-norm of G is the largest column sum, G[i][j] = X[i + j].
+    PRECISION norm = 0;
+    for (int j = 0; j <= n; ++j) {
+      PRECISION sum = 0;
+      for (int i = 0; i <= n; ++i)
+        sum += abs_value(X[i + j]);
+      norm = std::max(norm, sum);
+    }
+
+    // Columns of the inverse are solutions for unit right hand sides.
+    SmallBuffer<PRECISION, 16> unit(np1);
+    SmallBuffer<PRECISION, 16> column(np1);
+    PRECISION inverse_norm = 0;
+    for (int j = 0; j <= n; ++j) {
+      std::fill(unit.begin(), unit.end(), (PRECISION) 0);
+      unit[j] = 1;
+      normal_solve(n, B, permutation, unit.data(), column.data());
+      PRECISION sum = 0;
+      for (int i = 0; i <= n; ++i)
+        sum += abs_value(column[i]);
+      inverse_norm = std::max(inverse_norm, sum);
+    }
+    condition = norm * inverse_norm;
+  }
+
+// Record the pivot swaps, the minimal pivot and the condition number of the factorized normal matrix in stats.
+  template<typename PRECISION>
+  void factorization_stats(int n, const PRECISION *X, const PRECISION *B, const int *permutation, int swaps,
+                           FitStats &stats) {
+    PRECISION min_pivot;
+    PRECISION condition;
+    normal_conditioning(n, X, B, permutation, min_pivot, condition);
+
+    stats.pivot_swaps += swaps;
+    stats.min_pivot = std::min(stats.min_pivot, (double) min_pivot);
+    stats.max_condition = std::max(stats.max_condition, (double) condition);
+    stats.last_condition = (double) condition;
+  }
+
+// Solve the normal equations into a, computing the residual, and check if the result can be trusted:
+// the pivots are not zero, the error bound (condition number times the machine epsilon) is within
+// tolerance, and the coefficients, residual and R^2 are sane. Returns false if a wider precision is needed.
+  template<int n, typename TYPE, typename PRECISION>
+  bool solve_if_accurate(const PRECISION *X, const PRECISION *Y, PRECISION YY, size_t N, double tolerance,
+                         Polynomial<n, TYPE, PRECISION> &a) {
+    PRECISION B[(n + 1) * (n + 1)];
+    int permutation[n + 1];
+    normal_factorize(n, X, B, permutation);
+
+    PRECISION min_pivot;
+    PRECISION condition;
+    normal_conditioning(n, X, B, permutation, min_pivot, condition);
+    double epsilon = (double) std::numeric_limits<PRECISION>::epsilon();
+    if (!(min_pivot > 0) || !((double) condition * epsilon <= tolerance))
+      return false;
+
+    std::array<PRECISION, n + 1> coefficients;
+    solve_coefficients<n>(X, Y, B, permutation, coefficients.data());
+    for (PRECISION c: coefficients)
+      if (!std::isfinite((double) c))
+        return false;
+
+    a = Polynomial<n, TYPE, PRECISION>(coefficients, true, N);
+    residual_from_sums(a, X, Y, YY);
+
+    // R^2 of least squares with the constant term cannot be negative unless the sums lost their precision.
+    return std::isfinite((double) a.residual()) && a.r_squared() >= 0;
+  }
+
+// Convert the polynomial into a wider precision, keeping track of the precision it was computed in.
+  template<typename WIDE, int n, typename TYPE, typename PRECISION>
+  Polynomial<n, TYPE, WIDE> widen_precision(const Polynomial<n, TYPE, PRECISION> &a) {
+    std::array<WIDE, n + 1> coefficients;
+    for (int k = 0; k <= n; ++k)
+      coefficients[k] = (WIDE) a[k];
+
+    Polynomial<n, TYPE, WIDE> wide(coefficients, true, a.data_size());
+    wide.residual((WIDE) a.residual());
+    wide.r_squared((WIDE) a.r_squared());
+    wide.precision_digits(a.precision_digits());
+    return wide;
+  }
+
+// Solve the normal equations as solve_normal_equations does, also computing the residual and recording
+// the timings and the properties of the normal matrix in stats.
+  template<int n, typename TYPE, typename PRECISION>
+  Polynomial<n, TYPE, PRECISION> solve_normal_equations(const PRECISION *X, const PRECISION *Y, PRECISION YY,
+                                                        size_t N, FitStats &stats) {
+    typedef std::chrono::steady_clock clock;
+    auto start = clock::now();
+
+    PRECISION B[(n + 1) * (n + 1)];
+    int permutation[n + 1];
+    int swaps = normal_factorize(n, X, B, permutation);
+    std::array<PRECISION, n + 1> a;
+    solve_coefficients<n>(X, Y, B, permutation, a.data());
+    Polynomial<n, TYPE, PRECISION> polynomial(a, true, N);
+    auto solved = clock::now();
+
+    residual_from_sums(polynomial, X, Y, YY);
+    auto end = clock::now();
+
+    stats.elimination += solved - start;
+    stats.residual += end - solved;
+    stats.fits++;
+    stats.data_points += N;
+    factorization_stats(n, X, B, permutation, swaps, stats);
+    return polynomial;
+  }
+
+// Compute the residual and R^2 exactly, in a second pass over X and Y, storing them in the polynomial.
+  template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+  void compute_residual_iter(Polynomial<n, TYPE, PRECISION> &a, ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N) {
+    PRECISION r = 0;
+
+    // Welford's algorithm for the sum of squared differences between Y and its mean
+    PRECISION mean = 0;
+    PRECISION total = 0;
+    for (size_t i = 0; i < N; i++) {
+      PRECISION x = (PRECISION) *x_iter;
+      PRECISION y = (PRECISION) *y_iter;
+      ++x_iter;
+      ++y_iter;
+
+      PRECISION diff = evaluate_precise(a, x) - y;
+      r = r + diff * diff;
+
+      PRECISION delta = y - mean;
+      mean += delta / (PRECISION) (i + 1);
+      total += delta * (y - mean);
+    }
+    a.residual(r);
+    a.r_squared(total > 0 ? 1 - r / total : (PRECISION) 1);
+  }
+
+// Iterator that enumerates X values 0, 1, 2 ...
+  struct EnumeratingIterator {
+    size_t x = 0;
+
+    size_t operator*() const {
+      return x;
+    }
+
+    EnumeratingIterator &operator++() {
+      ++x;
+      return *this;
+    }
+  };
+
+// Least squares projection for X enumerating 0 to fixed_size - 1. As X is constant, the coefficients
+// are linear combinations of Y values, a[k] = sigma(weights[i][k] * yi), and the weights can be computed once.
+// For built-in floating point types the weights (Savitzky-Golay coefficients) can be computed at compile time.
+  template<int n, int fixed_size, typename PRECISION>
+  class FixedProjection {
+  public:
+    constexpr FixedProjection() : weights_{} {
+      static_assert(fixed_size > 0);
+
+      // X = sigma(xi^k) for k = 0 .. 2n
+      PRECISION X[2 * n + 1] = {};
+      enumerated_power_sums<2 * n>(fixed_size, X);
+
+      // The weights of yi are the solution for the right hand side (xi^0, xi^1, ... xi^n).
+      NormalFactorization<n, PRECISION> factorization(X);
+      for (int i = 0; i < fixed_size; ++i) {
+        PRECISION x_raised[n + 1] = {};
+        PRECISION xx = 1;
+        for (int k = 0; k <= n; ++k) {
+          x_raised[k] = xx;
+          xx = xx * (PRECISION) i;
+        }
+        factorization.solve(x_raised, weights_[i].data());
+      }
+    }
+
+    // Fit over fixed_size Y values, this is a single matrix - vector product. The residual, if asked,
+    // is computed from the sums accumulated in the same pass.
+    template<typename TYPE, typename ITERATOR_Y>
+    Polynomial<n, TYPE, PRECISION> fit(ITERATOR_Y y_iter, bool compute_residual = false) const {
+      std::array<PRECISION, n + 1> a;
+      a.fill(0);
+      if (!compute_residual) {
+        for (int i = 0; i < fixed_size; ++i) {
+          PRECISION y = (PRECISION) *y_iter;
+          ++y_iter;
+          const std::array<PRECISION, n + 1> &w = weights_[i];
+          for (int k = 0; k <= n; ++k)
+            a[k] += w[k] * y;
+        }
+        return Polynomial<n, TYPE, PRECISION>(a, true, fixed_size);
       }
 
-    // Back substitution.
-    // (1) Set the variable as the rhs of last equation
-    // (2) Subtract all lhs values except the target coefficient.
-    // (3) Divide rhs by coefficient of variable being calculated.
-    for (int i = n; i >= 0; --i) {
-      a[i] = B[i][np1];                 // (1)
-      for (int j = 0; j < np1; ++j)
-        if (j != i)
-          a[i] -= B[i][j] * a[j];       // (2)
-      a[i] /= B[i][i];                  // (3)
-    }
-
-    if (compute_residual) {
-      PRECISION r = 0;
-      ITERATOR_Y y_iter_iter = y_iter;
-      for (int i = 0; i < N; i++) {
-        PRECISION x = x_raised[1][i];
-        PRECISION diff = a(x) - (*y_iter_iter++);
-        r = r + diff * diff;
+      // Y = sigma(xi^k * yi), YY = sigma(yi^2)
+      PRECISION Y[n + 1] = {};
+      PRECISION YY = 0;
+      for (int i = 0; i < fixed_size; ++i) {
+        PRECISION y = (PRECISION) *y_iter;
+        ++y_iter;
+        const std::array<PRECISION, n + 1> &w = weights_[i];
+        PRECISION xx = 1;
+        for (int k = 0; k <= n; ++k) {
+          a[k] += w[k] * y;
+          Y[k] += xx * y;
+          xx = xx * (PRECISION) i;
+        }
+        YY += y * y;
       }
-      a.residual(r);
+
+      Polynomial<n, TYPE, PRECISION> polynomial(a, true, fixed_size);
+      PRECISION X[2 * n + 1];
+      enumerated_power_sums<2 * n>(fixed_size, X);
+      residual_from_sums(polynomial, X, Y, YY);
+      return polynomial;
     }
-    return a;
-  }
+
+    // Weight of the Y value at x = i in the coefficient k.
+    constexpr PRECISION weight(int i, int k) const {
+      return weights_[i][k];
+    }
+
+  private:
+    std::array<std::array<PRECISION, n + 1>, fixed_size> weights_;
+  };
+
+// Fixed size projections up to this size ((n + 1)^2 * fixed_size) are computed at compile time, larger
+// ones on the first call. This keeps the compile time and the compiler's constexpr limits in check.
+  constexpr long max_constexpr_projection = 1L << 13;
+
+// True if the projection for this order, size and precision is computed at compile time.
+  template<int n, int fixed_size, typename PRECISION>
+  constexpr bool is_constexpr_projection = std::is_floating_point<PRECISION>::value &&
+                                           (long) (n + 1) * (n + 1) * fixed_size <= max_constexpr_projection;
 }
 #endif
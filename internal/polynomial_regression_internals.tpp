@@ -1,6 +1,107 @@
 #include <string.h>
 #include <cassert>
 
+// Fit the constant or the straight line in a single pass, updating the means and the centered sums of squares
+// and products (Welford's algorithm). Unlike the raw sums, these do not lose precision if X or Y are far from zero.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+Polynomial<n, TYPE, PRECISION> centered_regression_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                                        bool compute_residual) {
+  static_assert(n == 0 || n == 1);
+  PRECISION mean_x = 0;
+  PRECISION mean_y = 0;
+  PRECISION sxx = 0;
+  PRECISION sxy = 0;
+  PRECISION syy = 0;
+  for (size_t i = 0; i < N; ++i) {
+    PRECISION x = (PRECISION) *x_iter;
+    PRECISION y = (PRECISION) *y_iter;
+    ++x_iter;
+    ++y_iter;
+
+    PRECISION w = 1 / (PRECISION) (i + 1);
+    PRECISION dx = x - mean_x;
+    PRECISION dy = y - mean_y;
+    mean_x += dx * w;
+    mean_y += dy * w;
+    if constexpr (n == 1) {
+      sxx += dx * (x - mean_x);
+      sxy += dx * (y - mean_y);
+    }
+    syy += dy * (y - mean_y);
+  }
+
+  std::array<PRECISION, n + 1> a;
+  PRECISION r = syy;
+  if constexpr (n == 0) {
+    a[0] = mean_y;
+  } else {
+    a[1] = sxy / sxx;
+    a[0] = mean_y - a[1] * mean_x;
+    r -= a[1] * sxy;
+    if (r < 0)
+      r = 0;
+  }
+
+  Polynomial<n, TYPE, PRECISION> polynomial(a, true, N);
+  if (compute_residual) {
+    polynomial.residual(r);
+    polynomial.r_squared(syy > 0 ? 1 - r / syy : (PRECISION) 1);
+  }
+  return polynomial;
+}
+
+// The number of data points copied at once by add_shifted.
+constexpr size_t shifted_block_size = 256;
+
+// Add N data points as (xi - x0, yi - y0). The points are copied into blocks of PRECISION, so the vectorized
+// kernels still apply. If the data are far from zero but x0, y0 is one of the points, the shifted sums keep
+// the precision that the raw ones lose.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+void add_shifted(RegressionAccumulator<n, TYPE, PRECISION> &accumulator, ITERATOR_X x_iter, ITERATOR_Y y_iter,
+                 size_t N, PRECISION x0, PRECISION y0) {
+  PRECISION x[shifted_block_size];
+  PRECISION y[shifted_block_size];
+  for (size_t from = 0; from < N; from += shifted_block_size) {
+    size_t m = std::min(shifted_block_size, N - from);
+    for (size_t i = 0; i < m; ++i) {
+      x[i] = (PRECISION) *x_iter - x0;
+      y[i] = (PRECISION) *y_iter - y0;
+      ++x_iter;
+      ++y_iter;
+    }
+    accumulator.add(x, y, m);
+  }
+}
+
+// Solve the accumulated sums, computing the residual and R^2 from the same sums only if required.
+template<int n, typename TYPE, typename PRECISION>
+Polynomial<n, TYPE, PRECISION> solve_accumulated(const RegressionAccumulator<n, TYPE, PRECISION> &accumulator,
+                                                 bool compute_residual) {
+  if (compute_residual)
+    return accumulator.solve();
+  return solve_normal_equations<n, TYPE, PRECISION>(accumulator.x_sums().data(), accumulator.xy_sums().data(),
+                                                    accumulator.size());
+}
+
+// Move the polynomial fitted over (xi - x0, yi - y0) back to a(x) = c(x - x0) + y0 (Taylor shift).
+// The residual and R^2 do not change.
+template<int n, typename TYPE, typename PRECISION>
+Polynomial<n, TYPE, PRECISION> unshift_polynomial(const Polynomial<n, TYPE, PRECISION> &c, PRECISION x0,
+                                                  PRECISION y0) {
+  std::array<PRECISION, n + 1> a;
+  for (int k = 0; k <= n; ++k)
+    a[k] = c[k];
+  for (int i = 0; i < n; ++i)
+    for (int k = n - 1; k >= i; --k)
+      a[k] -= x0 * a[k + 1];
+  a[0] += y0;
+
+  Polynomial<n, TYPE, PRECISION> polynomial(a, true, c.data_size());
+  polynomial.residual(c.residual());
+  polynomial.r_squared(c.r_squared());
+  return polynomial;
+}
+
 // Perform polynomial regression using X and Y iterators
 template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
 Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter,
@@ -9,10 +110,96 @@ Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter,
                                                      size_t N) {
   static_assert(n >= 0);
 
-  // X values raised in degree.
-  std::array<std::vector<PRECISION>, 2 * n + 1> x_raised;
-  build_x_matrix<2 * n + 1, PRECISION, ITERATOR_X>(x_iter, N, x_raised);
-  return polynomial_regression_iter<n, TYPE, PRECISION, ITERATOR_Y>(x_raised, y_iter, compute_residual, N);
+  // Orders 0 and 1 that are not vectorized keep the centered sums, that costs about the same.
+  if constexpr (n <= 1 && !is_simd_accumulated<ITERATOR_X, ITERATOR_Y, PRECISION>) {
+    return centered_regression_iter<n, TYPE, PRECISION>(x_iter, y_iter, N, compute_residual);
+  }
+
+  // Other orders solved in closed form accumulate the sums relative to the first data point, see add_shifted.
+  if constexpr (n <= 2) {
+    if (N > 0) {
+      PRECISION x0 = (PRECISION) *x_iter;
+      PRECISION y0 = (PRECISION) *y_iter;
+      RegressionAccumulator<n, TYPE, PRECISION> accumulator;
+      add_shifted(accumulator, x_iter, y_iter, N, x0, y0);
+      return unshift_polynomial(solve_accumulated(accumulator, compute_residual), x0, y0);
+    }
+  }
+
+  // Single pass over X and Y, keeping only the sums. The residual, if asked, is computed from the same sums.
+  RegressionAccumulator<n, TYPE, PRECISION> accumulator;
+  accumulator.add(x_iter, y_iter, N);
+  return solve_accumulated(accumulator, compute_residual);
+}
+
+// The number of data points in one chunk of the reproducible parallel regression.
+constexpr size_t reproducible_chunk_size = 1 << 16;
+
+// Perform polynomial regression using X and Y iterators and multiple threads.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter,
+                                                     ITERATOR_Y y_iter,
+                                                     size_t N, Parallel parallel, bool compute_residual) {
+  static_assert(n >= 0);
+
+  constexpr bool random_access =
+      std::is_base_of<std::random_access_iterator_tag,
+          typename std::iterator_traits<ITERATOR_X>::iterator_category>::value &&
+      std::is_base_of<std::random_access_iterator_tag,
+          typename std::iterator_traits<ITERATOR_Y>::iterator_category>::value;
+  if constexpr (!random_access) {
+    return polynomial_regression_iter<n, TYPE, PRECISION>(x_iter, y_iter, compute_residual, N);
+  } else {
+    unsigned threads = parallel.threads > 0 ? parallel.threads : std::thread::hardware_concurrency();
+    if (threads == 0)
+      threads = 1;
+
+    size_t chunk_size = parallel.reproducible ? reproducible_chunk_size : (N + threads - 1) / threads;
+    if (chunk_size == 0)
+      chunk_size = 1;
+    size_t chunks = (N + chunk_size - 1) / chunk_size;
+
+    // Sums of every chunk, merged in the order of chunks. Orders solved in closed form shift all chunks by
+    // the first data point, see add_shifted.
+    constexpr bool shifted = n <= 2;
+    PRECISION x0 = shifted && N > 0 ? (PRECISION) x_iter[0] : (PRECISION) 0;
+    PRECISION y0 = shifted && N > 0 ? (PRECISION) y_iter[0] : (PRECISION) 0;
+    std::vector<RegressionAccumulator<n, TYPE, PRECISION>> partial(chunks);
+    parallel_for_chunks(chunks, threads, [&](size_t chunk) {
+      size_t from = chunk * chunk_size;
+      size_t size = std::min(chunk_size, N - from);
+      if constexpr (shifted) {
+        add_shifted(partial[chunk], x_iter + from, y_iter + from, size, x0, y0);
+      } else {
+        partial[chunk].add(x_iter + from, y_iter + from, size);
+      }
+    });
+
+    // The residual, if asked, also comes from the merged sums.
+    RegressionAccumulator<n, TYPE, PRECISION> accumulator;
+    for (const auto &sums: partial)
+      accumulator.merge(sums);
+    if constexpr (shifted) {
+      return unshift_polynomial(solve_accumulated(accumulator, compute_residual), x0, y0);
+    } else {
+      return solve_accumulated(accumulator, compute_residual);
+    }
+  }
+}
+
+// Accumulate Y = sigma(xi^k * yi) for k = 0 .. n and YY = sigma(yi^2) with X enumerating 0 to N - 1.
+template<int n, typename PRECISION, typename ITERATOR_Y>
+void accumulate_enumerated_sums(ITERATOR_Y y_iter, size_t N, PRECISION *Y, PRECISION &YY) {
+  for (size_t ix = 0; ix < N; ix++) {
+    PRECISION y = (PRECISION) *y_iter;
+    ++y_iter;
+    PRECISION xx = 1;
+    for (int k = 0; k <= n; ++k) {
+      Y[k] += xx * y;
+      xx = xx * (PRECISION) ix;
+    }
+    YY += y * y;
+  }
 }
 
 // Perform polynomial regression Y iterator only (X enumerates 0 to N)
@@ -21,10 +208,61 @@ Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_Y y_iter,
                                                      bool compute_residual, size_t N) {
   static_assert(n >= 0);
 
-  // X values raised in degree.
-  std::array<std::vector<PRECISION>, 2 * n + 1> x_raised;
-  build_x_matrix<2 * n + 1, PRECISION>(N, x_raised);
-  return polynomial_regression_iter<n, TYPE, PRECISION, ITERATOR_Y>(x_raised, y_iter, compute_residual, N);
+  // X = sigma(xi^k) only depends on N, Y = sigma(xi^k * yi) and YY = sigma(yi^2) need a single pass over Y.
+  PRECISION X[2 * n + 1];
+  enumerated_power_sums<2 * n>(N, X);
+
+  PRECISION Y[n + 1] = {};
+  PRECISION YY = 0;
+  accumulate_enumerated_sums<n>(y_iter, N, Y, YY);
+  Polynomial<n, TYPE, PRECISION> a = solve_normal_equations<n, TYPE, PRECISION>(X, Y, N);
+
+  if (compute_residual) {
+    residual_from_sums(a, X, Y, YY);
+  }
+  return a;
+}
+
+// Perform polynomial regression using X and Y iterators, recording statistics.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                                          FitStats &stats) {
+  static_assert(n >= 0);
+  auto start = std::chrono::steady_clock::now();
+  // Orders solved in closed form accumulate relative to the first data point, as polynomial_regression_iter does.
+  RegressionAccumulator<n, TYPE, PRECISION> accumulator;
+  PRECISION x0 = 0;
+  PRECISION y0 = 0;
+  if constexpr (n <= 2) {
+    if (N > 0) {
+      x0 = (PRECISION) *x_iter;
+      y0 = (PRECISION) *y_iter;
+    }
+    add_shifted(accumulator, x_iter, y_iter, N, x0, y0);
+  } else {
+    accumulator.add(x_iter, y_iter, N);
+  }
+  stats.accumulation += std::chrono::steady_clock::now() - start;
+
+  Polynomial<n, TYPE, PRECISION> a = solve_normal_equations<n, TYPE, PRECISION>(
+      accumulator.x_sums().data(), accumulator.xy_sums().data(), accumulator.yy_sum(), N, stats);
+  return n <= 2 ? unshift_polynomial(a, x0, y0) : a;
+}
+
+// Perform polynomial regression using Y iterator only (X enumerates 0 to N), recording statistics.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_Y>
+Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_Y y_iter, size_t N, FitStats &stats) {
+  static_assert(n >= 0);
+  auto start = std::chrono::steady_clock::now();
+  PRECISION X[2 * n + 1];
+  enumerated_power_sums<2 * n>(N, X);
+
+  PRECISION Y[n + 1] = {};
+  PRECISION YY = 0;
+  accumulate_enumerated_sums<n>(y_iter, N, Y, YY);
+  stats.accumulation += std::chrono::steady_clock::now() - start;
+
+  return solve_normal_equations<n, TYPE, PRECISION>(X, Y, YY, N, stats);
 }
 
 // Perform polynomial regression using Y iterator only (X enumerates 0 to N assuming the fixed sample size)
@@ -32,14 +270,17 @@ template<int n, int fixed_size, typename TYPE, typename PRECISION, typename ITER
 Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_Y y_iter, bool compute_residual) {
   static_assert(n >= 0);
 
-  // X values raised in degree, static to compute oly once
-  static std::array<std::vector<PRECISION>, 2 * n + 1> x_raised;
-  if (x_raised[0].empty()) {
-    // Build once on the first call.
-    build_x_matrix<2 * n + 1, PRECISION>(fixed_size, x_raised);
+  Polynomial<n, TYPE, PRECISION> a;
+  if constexpr (is_constexpr_projection<n, fixed_size, PRECISION>) {
+    // Computed at compile time, the fit is n + 1 dot products with constant weights.
+    static constexpr FixedProjection<n, fixed_size, PRECISION> projection;
+    a = projection.template fit<TYPE>(y_iter, compute_residual);
+  } else {
+    // Computed on the first call. Initialization of the local static is thread safe.
+    static const FixedProjection<n, fixed_size, PRECISION> projection;
+    a = projection.template fit<TYPE>(y_iter, compute_residual);
   }
-
-  return polynomial_regression_iter<n, TYPE, PRECISION, ITERATOR_Y>(x_raised, y_iter, compute_residual, fixed_size);
+  return a;
 }
 
 // Perform polynomial regression over two collections that may have different type but expecting the same size
@@ -49,7 +290,25 @@ Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_X &x,
                                                          const COLLECTION_Y &y, bool compute_residual) {
   assert(x.size() == y.size());
   assert(x.size() > 0);
-  return polynomial_regression_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), compute_residual, x.size());
+  if constexpr (is_contiguous_collection<COLLECTION_X>::value && is_contiguous_collection<COLLECTION_Y>::value) {
+    // Pointers allow to use vectorized kernels
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.data(), y.data(), compute_residual, x.size());
+  } else {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), compute_residual, x.size());
+  }
+}
+
+// Perform polynomial regression over two collections, recording statistics.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_X &x, const COLLECTION_Y &y,
+                                                         FitStats &stats) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  if constexpr (is_contiguous_collection<COLLECTION_X>::value && is_contiguous_collection<COLLECTION_Y>::value) {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.data(), y.data(), x.size(), stats);
+  } else {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), x.size(), stats);
+  }
 }
 
 template<int order, typename TYPE, typename PRECISION,
@@ -60,6 +319,23 @@ Polynomial<order, TYPE, PRECISION> polynomial_regression(COLLECTION_X &x,
 }
 
 
+// Perform polynomial regression over two collections using multiple threads.
+template<int order, typename TYPE, typename PRECISION,
+    typename COLLECTION_X, typename COLLECTION_Y>
+Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_X &x,
+                                                         const COLLECTION_Y &y,
+                                                         Parallel parallel, bool compute_residual) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  if constexpr (is_contiguous_collection<COLLECTION_X>::value && is_contiguous_collection<COLLECTION_Y>::value) {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.data(), y.data(), x.size(), parallel,
+                                                              compute_residual);
+  } else {
+    return polynomial_regression_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), x.size(), parallel,
+                                                              compute_residual);
+  }
+}
+
 // Perform polynomial regression over single collection (x simply changes 0 to N)
 template<int order, typename TYPE, typename PRECISION, typename COLLECTION_Y>
 Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_Y &y, bool compute_residual) {
@@ -67,11 +343,794 @@ Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_Y &y,
   return polynomial_regression_iter<order, TYPE, PRECISION>(y.cbegin(), compute_residual, y.size());
 }
 
+// Perform polynomial regression over single collection (x simply changes 0 to N), recording statistics.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_Y>
+Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_Y &y, FitStats &stats) {
+  assert(y.size() > 0);
+  return polynomial_regression_iter<order, TYPE, PRECISION>(y.cbegin(), y.size(), stats);
+}
+
+// Perform polynomial regression over the samples from first to last, reading X and Y using projections.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR,
+    typename PROJECTION_X, typename PROJECTION_Y, typename FILTER>
+Polynomial<n, TYPE, PRECISION> polynomial_regression_projected_iter(ITERATOR first, ITERATOR last,
+                                                                    PROJECTION_X projection_x,
+                                                                    PROJECTION_Y projection_y,
+                                                                    FILTER keep, bool skip_nan,
+                                                                    bool compute_residual) {
+  static_assert(n >= 0);
+
+  // Kept values are copied into blocks, so that the accumulator can use the vectorized kernels. Orders solved
+  // in closed form are shifted by the first kept sample on the way, see add_shifted.
+  constexpr bool shifted = n <= 2;
+  constexpr size_t block = shifted_block_size;
+  PRECISION xs[block];
+  PRECISION ys[block];
+  PRECISION x0 = 0;
+  PRECISION y0 = 0;
+  bool first_kept = true;
+  RegressionAccumulator<n, TYPE, PRECISION> accumulator;
+
+  while (first != last) {
+    size_t m = 0;
+    while (m < block && first != last) {
+      const auto &sample = *first;
+      ++first;
+      if (!keep(sample))
+        continue;
+
+      PRECISION x = (PRECISION) std::invoke(projection_x, sample);
+      PRECISION y = (PRECISION) std::invoke(projection_y, sample);
+      if (skip_nan && (x != x || y != y))
+        continue;
+      if (shifted && first_kept) {
+        x0 = x;
+        y0 = y;
+        first_kept = false;
+      }
+      xs[m] = x - x0;
+      ys[m] = y - y0;
+      m++;
+    }
+    accumulator.add(&xs[0], &ys[0], m);
+  }
+  return unshift_polynomial(solve_accumulated(accumulator, compute_residual), x0, y0);
+}
+
+// Perform polynomial regression over a collection of samples, reading X and Y using projections.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION,
+    typename PROJECTION_X, typename PROJECTION_Y, typename FILTER>
+Polynomial<order, TYPE, PRECISION> polynomial_regression_projected(const COLLECTION &samples,
+                                                                   PROJECTION_X projection_x,
+                                                                   PROJECTION_Y projection_y,
+                                                                   FILTER keep, bool skip_nan,
+                                                                   bool compute_residual) {
+  return polynomial_regression_projected_iter<order, TYPE, PRECISION>(std::cbegin(samples), std::cend(samples),
+                                                                      projection_x, projection_y, keep, skip_nan,
+                                                                      compute_residual);
+}
+
 // Perform polynomial regression over single collection assuming the fixed sample size (x simply changes 0 to N)
-// Assuming fixed size allows to compute the x_raised matrix only once.
+// Assuming fixed size allows to compute the least squares projection only once.
 template<int order, int fixed_size, typename TYPE, typename PRECISION, typename COLLECTION_Y>
 Polynomial<order, TYPE, PRECISION> polynomial_regression_fixed(const COLLECTION_Y &y, bool compute_residual) {
-  assert(y.size() <= fixed_size);
+  assert(y.size() >= fixed_size);
   return polynomial_regression_iter<order, fixed_size, TYPE, PRECISION>(y.cbegin(), compute_residual);
 }
 
+// Fit many Y series, stored in a single matrix, against the same X, writing results into out.
+// Y = sigma(xi^k * yi) for every series and YY = sigma(yi^2) for every series must be zero filled.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X>
+void batch_fit(ITERATOR_X x_iter, const TYPE *y, size_t N, size_t series, Layout layout, bool compute_residual,
+               PRECISION *Y, PRECISION *YY, Polynomial<n, TYPE, PRECISION> *out) {
+  constexpr int np1 = n + 1;
+  constexpr int tnp1 = 2 * n + 1;
+
+  // X = sigma(xi^k), shared by all series.
+  PRECISION X[tnp1] = {};
+
+  // Stride to the next data point and to the next series.
+  size_t point_stride = layout == Layout::ROW_MAJOR ? series : 1;
+  size_t series_stride = layout == Layout::ROW_MAJOR ? 1 : N;
+
+  ITERATOR_X x_iter_iter = x_iter;
+  for (size_t i = 0; i < N; ++i) {
+    PRECISION x = (PRECISION) *x_iter_iter;
+    ++x_iter_iter;
+
+    PRECISION x_raised[tnp1];
+    PRECISION xx = 1;
+    for (int k = 0; k < tnp1; ++k) {
+      x_raised[k] = xx;
+      X[k] += xx;
+      xx = xx * x;
+    }
+
+    const TYPE *y_row = y + i * point_stride;
+    for (size_t s = 0; s < series; ++s) {
+      PRECISION yy = (PRECISION) y_row[s * series_stride];
+      PRECISION *Y_s = &Y[s * np1];
+      for (int k = 0; k < np1; ++k)
+        Y_s[k] += x_raised[k] * yy;
+      YY[s] += yy * yy;
+    }
+  }
+
+  NormalFactorization<n, PRECISION> factorization(X);
+  for (size_t s = 0; s < series; ++s) {
+    out[s] = factorization.template solve<TYPE>(&Y[s * np1], N);
+    if (compute_residual) {
+      residual_from_sums(out[s], X, &Y[s * np1], YY[s]);
+    }
+  }
+}
+
+// Perform polynomial regression of many Y series, stored in a single matrix, against the same X.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X>
+std::vector<Polynomial<n, TYPE, PRECISION>> polynomial_regression_batch_iter(ITERATOR_X x_iter, const TYPE *y,
+                                                                             size_t N, size_t series,
+                                                                             Layout layout,
+                                                                             bool compute_residual) {
+  static_assert(n >= 0);
+  std::vector<PRECISION> Y(series * (n + 1), 0);
+  std::vector<PRECISION> YY(series, 0);
+  std::vector<Polynomial<n, TYPE, PRECISION>> result(series);
+  batch_fit(x_iter, y, N, series, layout, compute_residual, Y.data(), YY.data(), result.data());
+  return result;
+}
+
+// Perform polynomial regression of many Y series, stored in a single matrix, against the same X,
+// with the reusable workspace.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X>
+void polynomial_regression_batch_iter(ITERATOR_X x_iter, const TYPE *y, size_t N, size_t series,
+                                      RegressionWorkspace<PRECISION> &workspace,
+                                      Polynomial<n, TYPE, PRECISION> *out,
+                                      Layout layout, bool compute_residual) {
+  static_assert(n >= 0);
+  batch_fit(x_iter, y, N, series, layout, compute_residual,
+            workspace.xy_sums(n, series), workspace.yy_sums(series), out);
+}
+
+// Perform polynomial regression of many Y series against the same X.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_YS>
+std::vector<Polynomial<order, TYPE, PRECISION>> polynomial_regression_batch(const COLLECTION_X &x,
+                                                                            const COLLECTION_YS &ys,
+                                                                            bool compute_residual) {
+  static_assert(order >= 0);
+  constexpr int np1 = order + 1;
+  constexpr int tnp1 = 2 * order + 1;
+  size_t N = x.size();
+  assert(N > 0);
+
+  // X = sigma(xi^k), shared by all series.
+  PRECISION X[tnp1] = {};
+  for (auto xi: x) {
+    PRECISION xx = 1;
+    for (int k = 0; k < tnp1; ++k) {
+      X[k] += xx;
+      xx = xx * (PRECISION) xi;
+    }
+  }
+
+  NormalFactorization<order, PRECISION> factorization(X);
+
+  std::vector<Polynomial<order, TYPE, PRECISION>> result;
+  result.reserve(ys.size());
+  for (const auto &y: ys) {
+    assert(y.size() == N);
+
+    // Y = sigma(xi^k * yi) and YY = sigma(yi^2) for this series.
+    PRECISION Y[np1] = {};
+    PRECISION YY = 0;
+    auto y_iter = y.cbegin();
+    for (auto xi: x) {
+      PRECISION yy = (PRECISION) *y_iter;
+      ++y_iter;
+      PRECISION xx = 1;
+      for (int k = 0; k < np1; ++k) {
+        Y[k] += xx * yy;
+        xx = xx * (PRECISION) xi;
+      }
+      YY += yy * yy;
+    }
+
+    result.push_back(factorization.template solve<TYPE>(Y, N));
+    if (compute_residual) {
+      residual_from_sums(result.back(), X, Y, YY);
+    }
+  }
+  return result;
+}
+
+// Compute the residual exactly, in a second pass over X and Y.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+void polynomial_residual(Polynomial<order, TYPE, PRECISION> &polynomial, const COLLECTION_X &x,
+                         const COLLECTION_Y &y) {
+  assert(x.size() == y.size());
+  compute_residual_iter(polynomial, x.cbegin(), y.cbegin(), x.size());
+}
+
+// Compute the residual exactly, in a second pass over Y (X enumerates 0 to N).
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_Y>
+void polynomial_residual(Polynomial<order, TYPE, PRECISION> &polynomial, const COLLECTION_Y &y) {
+  compute_residual_iter(polynomial, EnumeratingIterator(), y.cbegin(), y.size());
+}
+
+// Find the center and the scale that map X into [-1, 1].
+template<typename PRECISION, typename ITERATOR_X>
+void find_center_scale(ITERATOR_X x_iter, size_t N, PRECISION &center, PRECISION &scale) {
+  PRECISION min = N > 0 ? (PRECISION) *x_iter : 0;
+  PRECISION max = min;
+  for (size_t i = 0; i < N; ++i) {
+    PRECISION x = (PRECISION) *x_iter;
+    ++x_iter;
+    if (x < min)
+      min = x;
+    if (x > max)
+      max = x;
+  }
+  center = (min + max) / 2;
+  scale = (max - min) / 2;
+  if (scale == 0)
+    scale = 1;
+}
+
+// Factorize the least squares problem in the Chebyshev basis over X mapped into [-1, 1]. This takes two passes
+// over X: the first one finds the range, the second one adds the data points to the factorization.
+template<int n, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+ChebyshevQr<n, PRECISION> build_chebyshev_qr(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N) {
+  PRECISION center;
+  PRECISION scale;
+  find_center_scale(x_iter, N, center, scale);
+
+  ChebyshevQr<n, PRECISION> qr(center, scale);
+  for (size_t i = 0; i < N; ++i) {
+    qr.add((PRECISION) *x_iter, (PRECISION) *y_iter);
+    ++x_iter;
+    ++y_iter;
+  }
+  return qr;
+}
+
+// Perform numerically stable polynomial regression using X and Y iterators.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+Polynomial<n, TYPE, PRECISION> polynomial_regression_stable_iter(ITERATOR_X x_iter,
+                                                            ITERATOR_Y y_iter,
+                                                            size_t N, bool compute_residual) {
+  static_assert(n >= 0);
+
+  ChebyshevQr<n, PRECISION> qr = build_chebyshev_qr<n, PRECISION>(x_iter, y_iter, N);
+
+  std::array<PRECISION, n + 1> a;
+  qr.solve(n, a.data());
+  Polynomial<n, TYPE, PRECISION> polynomial(a, true, N);
+
+  if (compute_residual) {
+    // The residual of degree 0 fit is the sum of squared differences between Y and its mean.
+    PRECISION r = qr.residual(n);
+    PRECISION total = qr.residual(0);
+    polynomial.residual(r);
+    polynomial.r_squared(total > 0 ? 1 - r / total : (PRECISION) 1);
+  }
+  return polynomial;
+}
+
+// Perform numerically stable polynomial regression over two collections.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+Polynomial<order, TYPE, PRECISION> polynomial_regression_stable(const COLLECTION_X &x,
+                                                                const COLLECTION_Y &y,
+                                                                bool compute_residual) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  return polynomial_regression_stable_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), x.size(),
+                                                                   compute_residual);
+}
+
+// Fit polynomials of every degree 0 .. n using X and Y iterators.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+OrthogonalFit<n, TYPE, PRECISION> polynomial_regression_all_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N) {
+  static_assert(n >= 0);
+  return OrthogonalFit<n, TYPE, PRECISION>(build_chebyshev_qr<n, PRECISION>(x_iter, y_iter, N));
+}
+
+// Fit polynomials of every degree 0 .. order over two collections.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+OrthogonalFit<order, TYPE, PRECISION> polynomial_regression_all(const COLLECTION_X &x, const COLLECTION_Y &y) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  return polynomial_regression_all_iter<order, TYPE, PRECISION>(x.cbegin(), y.cbegin(), x.size());
+}
+
+// Perform polynomial regression using X and Y iterators in FAST precision, repeating it in WIDE precision
+// if the fast result cannot be trusted.
+template<int n, typename TYPE, typename FAST, typename WIDE, typename ITERATOR_X, typename ITERATOR_Y>
+Polynomial<n, TYPE, WIDE> polynomial_regression_escalating_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                                                double tolerance) {
+  static_assert(n >= 0);
+  // Orders solved in closed form accumulate relative to the first data point, as polynomial_regression_iter does.
+  RegressionAccumulator<n, TYPE, FAST> fast;
+  FAST x0 = 0;
+  FAST y0 = 0;
+  if constexpr (n <= 2) {
+    if (N > 0) {
+      x0 = (FAST) *x_iter;
+      y0 = (FAST) *y_iter;
+    }
+    add_shifted(fast, x_iter, y_iter, N, x0, y0);
+  } else {
+    fast.add(x_iter, y_iter, N);
+  }
+  Polynomial<n, TYPE, FAST> a;
+  if (solve_if_accurate(fast.x_sums().data(), fast.xy_sums().data(), fast.yy_sum(), N, tolerance, a))
+    return widen_precision<WIDE>(n <= 2 ? unshift_polynomial(a, x0, y0) : a);
+
+  // The sums themselves may have lost precision, so they are accumulated again.
+  return polynomial_regression_iter<n, TYPE, WIDE>(x_iter, y_iter, true, N);
+}
+
+// Perform polynomial regression over two collections, escalating the precision if required.
+template<int order, typename TYPE, typename FAST, typename WIDE, typename COLLECTION_X, typename COLLECTION_Y>
+Polynomial<order, TYPE, WIDE> polynomial_regression_escalating(const COLLECTION_X &x, const COLLECTION_Y &y,
+                                                               double tolerance) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  if constexpr (is_contiguous_collection<COLLECTION_X>::value && is_contiguous_collection<COLLECTION_Y>::value) {
+    return polynomial_regression_escalating_iter<order, TYPE, FAST, WIDE>(x.data(), y.data(), x.size(), tolerance);
+  } else {
+    return polynomial_regression_escalating_iter<order, TYPE, FAST, WIDE>(x.cbegin(), y.cbegin(), x.size(),
+                                                                          tolerance);
+  }
+}
+
+// Perform polynomial regression over single collection (x simply changes 0 to N), escalating the precision
+// if required.
+template<int order, typename TYPE, typename FAST, typename WIDE, typename COLLECTION_Y>
+Polynomial<order, TYPE, WIDE> polynomial_regression_escalating(const COLLECTION_Y &y, double tolerance) {
+  assert(y.size() > 0);
+  const size_t N = y.size();
+  FAST X[2 * order + 1];
+  enumerated_power_sums<2 * order>(N, X);
+
+  FAST Y[order + 1] = {};
+  FAST YY = 0;
+  accumulate_enumerated_sums<order>(y.cbegin(), N, Y, YY);
+  Polynomial<order, TYPE, FAST> a;
+  if (solve_if_accurate(X, Y, YY, N, tolerance, a))
+    return widen_precision<WIDE>(a);
+
+  return polynomial_regression_iter<order, TYPE, WIDE>(y.cbegin(), true, N);
+}
+
+// Perform polynomial surface regression z = f(x, y) of the total degree d using X, Y and Z iterators.
+template<int d, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y, typename ITERATOR_Z>
+Polynomial2D<d, TYPE, PRECISION> polynomial_regression_2d_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter,
+                                                               ITERATOR_Z z_iter, size_t N) {
+  static_assert(d >= 0);
+  constexpr int terms = Polynomial2D<d, TYPE, PRECISION>::terms;
+  constexpr int moments = (2 * d + 1) * (2 * d + 2) / 2;
+
+  // M = sigma(xi^p * yi^q) for p + q <= 2d, indexed as monomials of the degree 2d.
+  // Z = sigma(xi^i * yi^j * zi) for i + j <= d, ZZ = sigma(zi^2).
+  PRECISION M[moments] = {};
+  PRECISION Z[terms] = {};
+  PRECISION ZZ = 0;
+
+  for (size_t point = 0; point < N; ++point) {
+    PRECISION x = (PRECISION) *x_iter;
+    PRECISION y = (PRECISION) *y_iter;
+    PRECISION z = (PRECISION) *z_iter;
+    ++x_iter;
+    ++y_iter;
+    ++z_iter;
+
+    // Powers are computed once per point and shared by all moments.
+    PRECISION x_raised[2 * d + 1];
+    PRECISION y_raised[2 * d + 1];
+    PRECISION zy_raised[d + 1];
+    x_raised[0] = 1;
+    y_raised[0] = 1;
+    for (int k = 1; k <= 2 * d; ++k) {
+      x_raised[k] = x_raised[k - 1] * x;
+      y_raised[k] = y_raised[k - 1] * y;
+    }
+    for (int j = 0; j <= d; ++j)
+      zy_raised[j] = z * y_raised[j];
+
+    // Moments with the same power of x are contiguous, so every row is a vectorizable update.
+    for (int p = 0; p <= 2 * d; ++p) {
+      PRECISION *row = M + monomial_index(2 * d, p, 0);
+      PRECISION xp = x_raised[p];
+      for (int q = 0; q <= 2 * d - p; ++q)
+        row[q] += xp * y_raised[q];
+    }
+    for (int i = 0; i <= d; ++i) {
+      PRECISION *row = Z + monomial_index(d, i, 0);
+      PRECISION xi = x_raised[i];
+      for (int j = 0; j <= d - i; ++j)
+        row[j] += xi * zy_raised[j];
+    }
+    ZZ += z * z;
+  }
+
+  // The normal matrix, G[(ia, ja)][(ib, jb)] = M[(ia + ib, ja + jb)]
+  PRECISION G[terms * terms];
+  for (int ia = 0; ia <= d; ++ia)
+    for (int ja = 0; ia + ja <= d; ++ja)
+      for (int ib = 0; ib <= d; ++ib)
+        for (int jb = 0; ib + jb <= d; ++jb)
+          G[monomial_index(d, ia, ja) * terms + monomial_index(d, ib, jb)] =
+              M[monomial_index(2 * d, ia + ib, ja + jb)];
+
+  PRECISION B[terms * terms];
+  int permutation[terms];
+  std::copy(G, G + terms * terms, B);
+  matrix_factorize(terms - 1, B, permutation);
+  std::array<PRECISION, terms> a;
+  normal_solve(terms - 1, B, permutation, Z, a.data());
+  Polynomial2D<d, TYPE, PRECISION> polynomial(a, true, N);
+
+  // The residual is expanded as a.G.a - 2 * a.Z + ZZ, as for one variable.
+  PRECISION aGa = 0;
+  PRECISION aZ = 0;
+  for (int i = 0; i < terms; ++i) {
+    PRECISION Ga = 0;
+    for (int j = 0; j < terms; ++j)
+      Ga += G[i * terms + j] * a[j];
+    aGa += a[i] * Ga;
+    aZ += a[i] * Z[i];
+  }
+  PRECISION r = aGa - 2 * aZ + ZZ;
+  if (r < 0)
+    r = 0;
+  PRECISION total = ZZ - Z[0] * Z[0] / (PRECISION) N;
+  polynomial.residual(r);
+  polynomial.r_squared(total > 0 ? 1 - r / total : (PRECISION) 1);
+  return polynomial;
+}
+
+// Perform polynomial surface regression z = f(x, y) over three collections of the same size.
+template<int degree, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y,
+    typename COLLECTION_Z>
+Polynomial2D<degree, TYPE, PRECISION> polynomial_regression_2d(const COLLECTION_X &x, const COLLECTION_Y &y,
+                                                               const COLLECTION_Z &z) {
+  assert(x.size() == y.size());
+  assert(x.size() == z.size());
+  assert(x.size() > 0);
+  return polynomial_regression_2d_iter<degree, TYPE, PRECISION>(x.cbegin(), y.cbegin(), z.cbegin(), x.size());
+}
+
+// Segment of the piecewise regression: the data points from .. to - 1, X measured from the knot left.
+template<int n, typename TYPE, typename PRECISION>
+struct PiecewiseSegment {
+  size_t from;
+  size_t to;
+  PRECISION left;
+
+  // Sums in the local coordinate x - left, and the unconstrained fit.
+  RegressionAccumulator<n, TYPE, PRECISION> sums;
+  Polynomial<n, TYPE, PRECISION> fit;
+};
+
+// Accumulate the sums of every segment in the local coordinate and solve them, segments in parallel.
+template<int n, typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+void fit_piecewise_segments(ITERATOR_X x_iter, ITERATOR_Y y_iter,
+                            std::vector<PiecewiseSegment<n, TYPE, PRECISION>> &segments, unsigned threads) {
+  if (threads == 0)
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  parallel_for_chunks(segments.size(), threads, [&](size_t s) {
+    PiecewiseSegment<n, TYPE, PRECISION> &segment = segments[s];
+    segment.sums.clear();
+    for (size_t i = segment.from; i < segment.to; ++i)
+      segment.sums.add((PRECISION) x_iter[i] - segment.left, (PRECISION) y_iter[i]);
+    segment.fit = segment.sums.solve();
+  });
+}
+
+// Solve the sums in the local coordinate for the polynomial that has the given value at the local zero,
+// a[0] = value. The remaining coefficients solve the normal equations of sigma(xi^j * (yi - value)) for j >= 1.
+template<int n, typename TYPE, typename PRECISION>
+Polynomial<n, TYPE, PRECISION> solve_anchored(const RegressionAccumulator<n, TYPE, PRECISION> &sums,
+                                              PRECISION value) {
+  const PRECISION *X = sums.x_sums().data();
+  const PRECISION *Y = sums.xy_sums().data();
+  std::array<PRECISION, n + 1> a;
+  a[0] = value;
+  if constexpr (n > 0) {
+    // The normal matrix of the powers 1 .. n is built from X[2] .. X[2n].
+    PRECISION rhs[n];
+    for (int j = 1; j <= n; ++j)
+      rhs[j - 1] = Y[j] - value * X[j];
+    PRECISION B[n * n];
+    int permutation[n];
+    normal_factorize(n - 1, X + 2, B, permutation);
+    normal_solve(n - 1, B, permutation, rhs, a.data() + 1);
+  }
+
+  Polynomial<n, TYPE, PRECISION> polynomial(a, true, sums.size());
+  residual_from_sums(polynomial, X, Y, sums.yy_sum());
+  return polynomial;
+}
+
+// Collect the fitted segments into the piecewise polynomial, constraining them for continuity if required.
+template<int n, typename TYPE, typename PRECISION>
+PiecewisePolynomial<n, TYPE, PRECISION> make_piecewise(std::vector<PiecewiseSegment<n, TYPE, PRECISION>> &segments,
+                                                       PRECISION right, bool continuous) {
+  std::vector<PRECISION> knots;
+  std::vector<PRECISION> coefficients;
+  knots.reserve(segments.size() + 1);
+  coefficients.reserve(segments.size() * (n + 1));
+
+  PRECISION residual = 0;
+  size_t size = 0;
+  for (size_t s = 0; s < segments.size(); ++s) {
+    PiecewiseSegment<n, TYPE, PRECISION> &segment = segments[s];
+    if (continuous && s > 0) {
+      const PiecewiseSegment<n, TYPE, PRECISION> &previous = segments[s - 1];
+      segment.fit = solve_anchored(segment.sums, evaluate_precise(previous.fit, segment.left - previous.left));
+    }
+    knots.push_back(segment.left);
+    for (int k = 0; k <= n; ++k)
+      coefficients.push_back(segment.fit[k]);
+    residual += segment.fit.residual();
+    size += segment.to - segment.from;
+  }
+  knots.push_back(right);
+
+  PiecewisePolynomial<n, TYPE, PRECISION> piecewise(std::move(knots), std::move(coefficients));
+  piecewise.residual(residual);
+  piecewise.data_size(size);
+  return piecewise;
+}
+
+// Perform piecewise polynomial regression over two random access collections with the given knots.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+PiecewisePolynomial<order, TYPE, PRECISION> polynomial_regression_piecewise(const COLLECTION_X &x,
+                                                                            const COLLECTION_Y &y,
+                                                                            const std::vector<PRECISION> &knots,
+                                                                            PiecewiseOptions options) {
+  assert(x.size() == y.size());
+  assert(knots.size() >= 2);
+  auto x_iter = x.cbegin();
+  auto x_end = x.cend();
+  auto less = [](const auto &value, PRECISION knot) { return (PRECISION) value < knot; };
+
+  std::vector<PiecewiseSegment<order, TYPE, PRECISION>> segments(knots.size() - 1);
+  for (size_t s = 0; s < segments.size(); ++s) {
+    segments[s].left = knots[s];
+    segments[s].from = std::lower_bound(x_iter, x_end, knots[s], less) - x_iter;
+    segments[s].to = s + 2 < knots.size() ? std::lower_bound(x_iter, x_end, knots[s + 1], less) - x_iter
+                                          : std::upper_bound(x_iter, x_end, knots[s + 1],
+                                                             [](PRECISION knot, const auto &value) {
+                                                               return knot < (PRECISION) value;
+                                                             }) - x_iter;
+  }
+
+  fit_piecewise_segments(x_iter, y.cbegin(), segments, options.threads);
+  return make_piecewise(segments, knots.back(), options.continuous);
+}
+
+// Perform piecewise polynomial regression over the given number of segments of equal width.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+PiecewisePolynomial<order, TYPE, PRECISION> polynomial_regression_piecewise(const COLLECTION_X &x,
+                                                                            const COLLECTION_Y &y,
+                                                                            size_t segments,
+                                                                            PiecewiseOptions options) {
+  assert(x.size() > 0);
+  assert(segments > 0);
+  PRECISION first = (PRECISION) x.cbegin()[0];
+  PRECISION last = (PRECISION) x.cbegin()[x.size() - 1];
+  std::vector<PRECISION> knots(segments + 1);
+  for (size_t s = 0; s < segments; ++s)
+    knots[s] = first + (last - first) * (PRECISION) s / (PRECISION) segments;
+  knots[segments] = last;
+  return polynomial_regression_piecewise<order, TYPE, PRECISION>(x, y, knots, options);
+}
+
+// Perform piecewise polynomial regression choosing the segments adaptively.
+template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+PiecewisePolynomial<order, TYPE, PRECISION> polynomial_regression_piecewise_adaptive(const COLLECTION_X &x,
+                                                                                     const COLLECTION_Y &y,
+                                                                                     PRECISION tolerance,
+                                                                                     size_t min_points,
+                                                                                     PiecewiseOptions options) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  typedef PiecewiseSegment<order, TYPE, PRECISION> Segment;
+  auto x_iter = x.cbegin();
+  auto y_iter = y.cbegin();
+  min_points = std::max(min_points, (size_t) order + 1);
+
+  // Segments of the current level are fitted together, those that are not good enough are split for the next one.
+  std::vector<Segment> done;
+  std::vector<Segment> level(1);
+  level[0].from = 0;
+  level[0].to = x.size();
+  level[0].left = (PRECISION) x_iter[0];
+  while (!level.empty()) {
+    fit_piecewise_segments(x_iter, y_iter, level, options.threads);
+    std::vector<Segment> next;
+    for (Segment &segment: level) {
+      size_t size = segment.to - segment.from;
+      size_t middle = segment.from + size / 2;
+      bool good = segment.fit.residual() <= tolerance * (PRECISION) size;
+      if (good || size / 2 < min_points || (PRECISION) x_iter[middle] <= segment.left) {
+        done.push_back(std::move(segment));
+        continue;
+      }
+      Segment left_half;
+      left_half.from = segment.from;
+      left_half.to = middle;
+      left_half.left = segment.left;
+      Segment right_half;
+      right_half.from = middle;
+      right_half.to = segment.to;
+      right_half.left = (PRECISION) x_iter[middle];
+      next.push_back(std::move(left_half));
+      next.push_back(std::move(right_half));
+    }
+    level = std::move(next);
+  }
+
+  std::sort(done.begin(), done.end(), [](const Segment &a, const Segment &b) { return a.from < b.from; });
+  return make_piecewise(done, (PRECISION) x_iter[x.size() - 1], options.continuous);
+}
+
+// Accumulate X = sigma(xi^k) for k = 0 .. 2n, Y = sigma(xi^k * yi) for k = 0 .. n and YY = sigma(yi^2)
+// for the order n given at runtime. X and Y must be zero filled.
+template<typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+void accumulate_sums_dynamic(int n, ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                             PRECISION *X, PRECISION *Y, PRECISION &YY) {
+  YY = 0;
+  for (size_t i = 0; i < N; ++i) {
+    PRECISION x = (PRECISION) *x_iter;
+    PRECISION y = (PRECISION) *y_iter;
+    ++x_iter;
+    ++y_iter;
+
+    PRECISION xx = 1;
+    for (int k = 0; k <= n; ++k) {
+      X[k] += xx;
+      Y[k] += xx * y;
+      xx = xx * x;
+    }
+    for (int k = n + 1; k <= 2 * n; ++k) {
+      X[k] += xx;
+      xx = xx * x;
+    }
+    YY += y * y;
+  }
+}
+
+// Solve the accumulated sums for the order n given at runtime, also computing the residual from them.
+template<typename TYPE, typename PRECISION>
+void solve_sums_dynamic(int n, const PRECISION *X, const PRECISION *Y, PRECISION YY, size_t N,
+                        PRECISION *B, int *permutation, DynamicPolynomial<TYPE, PRECISION> &a) {
+  solve_normal_equations_dynamic(n, X, Y, N, B, permutation, a);
+
+  PRECISION r;
+  PRECISION r_squared;
+  residual_from_sums(n, a.begin(), X, Y, YY, r, r_squared);
+  a.residual(r);
+  a.r_squared(r_squared);
+}
+
+// Perform polynomial regression of the order given at runtime using X and Y iterators.
+template<typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic_iter(int order, ITERATOR_X x_iter,
+                                                                      ITERATOR_Y y_iter, size_t N,
+                                                                      bool compute_residual) {
+  assert(order >= 0);
+  const int n = order;
+
+  // Buffers on the stack unless the order is high.
+  constexpr size_t inline_order = DynamicPolynomial<TYPE, PRECISION>::inline_coefficients;
+  SmallBuffer<PRECISION, 2 * inline_order> X(2 * n + 1);
+  SmallBuffer<PRECISION, inline_order> Y(n + 1);
+  SmallBuffer<PRECISION, inline_order * inline_order> B((n + 1) * (n + 1));
+  SmallBuffer<int, inline_order> permutation(n + 1);
+  PRECISION YY;
+  accumulate_sums_dynamic(n, x_iter, y_iter, N, X.data(), Y.data(), YY);
+
+  DynamicPolynomial<TYPE, PRECISION> a(n);
+  if (compute_residual) {
+    solve_sums_dynamic(n, X.data(), Y.data(), YY, N, B.data(), permutation.data(), a);
+  } else {
+    solve_normal_equations_dynamic(n, X.data(), Y.data(), N, B.data(), permutation.data(), a);
+  }
+  return a;
+}
+
+// Perform polynomial regression of the order given at runtime using X and Y iterators, recording statistics.
+template<typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic_iter(int order, ITERATOR_X x_iter,
+                                                                      ITERATOR_Y y_iter, size_t N,
+                                                                      FitStats &stats) {
+  assert(order >= 0);
+  const int n = order;
+  typedef std::chrono::steady_clock clock;
+  auto start = clock::now();
+
+  constexpr size_t inline_order = DynamicPolynomial<TYPE, PRECISION>::inline_coefficients;
+  SmallBuffer<PRECISION, 2 * inline_order> X(2 * n + 1);
+  SmallBuffer<PRECISION, inline_order> Y(n + 1);
+  PRECISION YY;
+  accumulate_sums_dynamic(n, x_iter, y_iter, N, X.data(), Y.data(), YY);
+  auto accumulated = clock::now();
+
+  SmallBuffer<PRECISION, inline_order * inline_order> B((n + 1) * (n + 1));
+  SmallBuffer<int, inline_order> permutation(n + 1);
+  DynamicPolynomial<TYPE, PRECISION> a(n);
+  int swaps = normal_factorize(n, X.data(), B.data(), permutation.data());
+  a.reset(n, N);
+  normal_solve(n, B.data(), permutation.data(), Y.data(), a.begin());
+  auto solved = clock::now();
+
+  PRECISION r;
+  PRECISION r_squared;
+  residual_from_sums(n, a.begin(), X.data(), Y.data(), YY, r, r_squared);
+  a.residual(r);
+  a.r_squared(r_squared);
+  auto end = clock::now();
+
+  stats.accumulation += accumulated - start;
+  stats.elimination += solved - accumulated;
+  stats.residual += end - solved;
+  stats.fits++;
+  stats.data_points += N;
+  auto heap_bytes = [](const auto &buffer) {
+    return buffer.allocated() ? buffer.size() * sizeof(buffer[0]) : 0;
+  };
+  size_t coefficient_bytes = n + 1 > (int) inline_order ? (n + 1) * sizeof(PRECISION) : 0;
+  stats.bytes_allocated += heap_bytes(X) + heap_bytes(Y) + heap_bytes(B) + heap_bytes(permutation) + coefficient_bytes;
+  factorization_stats(n, X.data(), B.data(), permutation.data(), swaps, stats);
+  return a;
+}
+
+// Perform polynomial regression of the order given at runtime over two collections, recording statistics.
+template<typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic(int order, const COLLECTION_X &x,
+                                                                 const COLLECTION_Y &y, FitStats &stats) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  return polynomial_regression_dynamic_iter<TYPE, PRECISION>(order, x.cbegin(), y.cbegin(), x.size(), stats);
+}
+
+// Perform polynomial regression of the order given at runtime using X and Y iterators, with the reusable workspace.
+template<typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+void polynomial_regression_dynamic_iter(int order, ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                        RegressionWorkspace<PRECISION> &workspace,
+                                        DynamicPolynomial<TYPE, PRECISION> &result, bool compute_residual) {
+  assert(order >= 0);
+  const int n = order;
+
+  PRECISION *X = workspace.x_sums(n);
+  PRECISION *Y = workspace.xy_sums(n);
+  PRECISION YY;
+  accumulate_sums_dynamic(n, x_iter, y_iter, N, X, Y, YY);
+  if (compute_residual) {
+    solve_sums_dynamic(n, X, Y, YY, N, workspace.matrix(n), workspace.permutation(n), result);
+  } else {
+    solve_normal_equations_dynamic(n, X, Y, N, workspace.matrix(n), workspace.permutation(n), result);
+  }
+}
+
+// Perform polynomial regression of the order given at runtime over two collections, with the reusable workspace.
+template<typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+void polynomial_regression_dynamic(int order, const COLLECTION_X &x, const COLLECTION_Y &y,
+                                   RegressionWorkspace<PRECISION> &workspace,
+                                   DynamicPolynomial<TYPE, PRECISION> &result, bool compute_residual) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  polynomial_regression_dynamic_iter(order, x.cbegin(), y.cbegin(), x.size(), workspace, result, compute_residual);
+}
+
+// Perform polynomial regression of the order given at runtime over two collections.
+template<typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic(int order, const COLLECTION_X &x,
+                                                                 const COLLECTION_Y &y,
+                                                                 bool compute_residual) {
+  assert(x.size() == y.size());
+  assert(x.size() > 0);
+  return polynomial_regression_dynamic_iter<TYPE, PRECISION>(order, x.cbegin(), y.cbegin(), x.size(),
+                                                             compute_residual);
+}
@@ -0,0 +1,168 @@
+#ifndef _POLYNOMIAL_REGRESSION_ABC_REGRESSION_KERNELS_H
+#define _POLYNOMIAL_REGRESSION_ABC_REGRESSION_KERNELS_H  __POLYNOMIAL_REGRESSION_ABC_REGRESSION_KERNELS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+// Kernels that take the polynomial order as a runtime argument. They are shared by the fixed order templates
+// and DynamicPolynomial, so that the code of the solver and evaluation is instantiated once per type rather
+// than once per order.
+
+namespace andviane {
+
+// Swap two values. std::swap is only constexpr since C++20.
+  template<typename T>
+  constexpr void swap_values(T &a, T &b) {
+    T t = a;
+    a = b;
+    b = t;
+  }
+
+// The position of x^i * y^j, i + j <= degree, among the monomials of two variables of the given total degree,
+// ordered by the degree of x, then by the degree of y.
+  constexpr int monomial_index(int degree, int i, int j) {
+    return i * (degree + 1) - i * (i - 1) / 2 + j;
+  }
+
+// LU factorize in place the (n + 1) x (n + 1) row major matrix B. B receives the eliminated matrix in the upper
+// triangle and the multipliers below the diagonal. permutation receives the row order after pivotisation.
+// The result can be solved with normal_solve. Returns the number of row swaps.
+  template<typename PRECISION>
+  constexpr int matrix_factorize(int n, PRECISION *B, int *permutation) {
+    const int np1 = n + 1;
+    int swaps = 0;
+
+    for (int i = 0; i <= n; ++i)
+      permutation[i] = i;
+
+    // Pivotisation of the B matrix.
+    for (int i = 0; i < np1; ++i)
+      for (int k = i + 1; k < np1; ++k)
+        if (B[i * np1 + i] < B[k * np1 + i]) {
+          for (int j = 0; j < np1; ++j) {
+            swap_values(B[i * np1 + j], B[k * np1 + j]);
+          }
+          swap_values(permutation[i], permutation[k]);
+          swaps++;
+        }
+
+    // Performs the Gaussian elimination, making all elements below the pivot equal to zero.
+    // The multipliers are stored in place of these zeros to apply them later on the right hand side.
+    for (int i = 0; i < n; ++i)
+      for (int k = i + 1; k < np1; ++k) {
+        PRECISION t = B[k * np1 + i] / B[i * np1 + i];
+        for (int j = i + 1; j < np1; ++j)
+          B[k * np1 + j] -= t * B[i * np1 + j];
+        B[k * np1 + i] = t;
+      }
+    return swaps;
+  }
+
+// LU factorize the normal matrix of n-th order polynomial regression, built from X = sigma(xi^k) for k = 0 .. 2n.
+// B is the (n + 1) x (n + 1) row major matrix that receives the factorization as in matrix_factorize.
+// Returns the number of row swaps.
+  template<typename PRECISION>
+  constexpr int normal_factorize(int n, const PRECISION *X, PRECISION *B, int *permutation) {
+    const int np1 = n + 1;
+    for (int i = 0; i <= n; ++i)
+      for (int j = 0; j <= n; ++j)
+        B[i * np1 + j] = X[i + j];
+    return matrix_factorize(n, B, permutation);
+  }
+
+// Solve the factorized normal equations for the right hand side Y = sigma(xi^k * yi) for k = 0 .. n,
+// writing the coefficients into a. Y and a must be different arrays.
+  template<typename PRECISION>
+  constexpr void normal_solve(int n, const PRECISION *B, const int *permutation, const PRECISION *Y, PRECISION *a) {
+    const int np1 = n + 1;
+
+    // Apply the pivotisation on the right hand side, a serves as the working storage.
+    for (int i = 0; i <= n; ++i)
+      a[i] = Y[permutation[i]];
+
+    // Apply the elimination on the right hand side.
+    for (int i = 0; i < n; ++i)
+      for (int k = i + 1; k < np1; ++k)
+        a[k] -= B[k * np1 + i] * a[i];
+
+    // Back substitution.
+    // (1) The variable is initially the rhs of its equation
+    // (2) Subtract all lhs values except the target coefficient.
+    // (3) Divide rhs by coefficient of variable being calculated.
+    for (int i = n; i >= 0; --i) {
+      for (int j = i + 1; j < np1; ++j)
+        a[i] -= B[i * np1 + j] * a[j];  // (2)
+      a[i] /= B[i * np1 + i];           // (3)
+    }
+  }
+
+// Compute the residual and R^2 of n-th order polynomial a from the sums X = sigma(xi^k) for k = 0 .. 2n,
+// Y = sigma(xi^k * yi) for k = 0 .. n, YY = sigma(yi^2). The residual is expanded as
+// sigma((a(xi) - yi)^2) = a.G.a - 2 * a.Y + YY where G[i][j] = X[i + j].
+  template<typename PRECISION>
+  void residual_from_sums(int n, const PRECISION *a, const PRECISION *X, const PRECISION *Y, PRECISION YY,
+                          PRECISION &residual, PRECISION &r_squared) {
+    PRECISION aGa = 0;
+    PRECISION aY = 0;
+    for (int i = 0; i <= n; ++i) {
+      PRECISION Ga = 0;
+      for (int j = 0; j <= n; ++j)
+        Ga += X[i + j] * a[j];
+      aGa += a[i] * Ga;
+      aY += a[i] * Y[i];
+    }
+
+    // Cannot be negative, but may appear so after rounding if the fit is exact.
+    PRECISION r = aGa - 2 * aY + YY;
+    if (r < 0)
+      r = 0;
+    residual = r;
+
+    // Y[0] = sigma(yi), X[0] = N
+    PRECISION total = YY - Y[0] * Y[0] / X[0];
+    r_squared = total > 0 ? 1 - r / total : (PRECISION) 1;
+  }
+
+// Evaluate the polynomial with the given count of coefficients at count points using Horner's scheme.
+// coefficient(n) returns the coefficient n, so the derivative or the integral can be evaluated
+// by computing their coefficients on the fly, without storing them.
+  template<typename PRECISION, typename TYPE, typename COEFFICIENT>
+  void evaluate_horner_with(COEFFICIENT coefficient, int size, const TYPE *xs, TYPE *out, size_t count) {
+    // Points are processed in blocks, the loops over points in a block have no dependencies and vectorize.
+    constexpr size_t block = 256;
+    PRECISION s[block];
+
+    for (size_t from = 0; from < count; from += block) {
+      size_t m = std::min(block, count - from);
+      const TYPE *x = xs + from;
+
+      PRECISION top = coefficient(size - 1);
+      for (size_t i = 0; i < m; i++)
+        s[i] = top;
+      for (int n = size - 2; n >= 0; n--) {
+        PRECISION c = coefficient(n);
+        for (size_t i = 0; i < m; i++)
+          s[i] = s[i] * (PRECISION) x[i] + c;
+      }
+
+      // If the "official type" happens to be integer or the like, we need a proper rounding.
+      if constexpr (std::is_integral<TYPE>::value) {
+        for (size_t i = 0; i < m; i++)
+          out[from + i] = (TYPE) std::round((double) s[i]);
+      } else {
+        for (size_t i = 0; i < m; i++)
+          out[from + i] = (TYPE) s[i];
+      }
+    }
+  }
+
+// Evaluate the polynomial with the given count of coefficients at count points using Horner's scheme.
+  template<typename TYPE, typename PRECISION>
+  void evaluate_horner(const PRECISION *coefficients, int size, const TYPE *xs, TYPE *out, size_t count) {
+    evaluate_horner_with<PRECISION>([coefficients](int n) { return coefficients[n]; }, size, xs, out, count);
+  }
+}
+
+#endif //_POLYNOMIAL_REGRESSION_ABC_REGRESSION_KERNELS_H
@@ -0,0 +1,153 @@
+#ifndef _POLYNOMIAL_REGRESSION_ABC_SIMD_KERNELS_H
+#define _POLYNOMIAL_REGRESSION_ABC_SIMD_KERNELS_H  __POLYNOMIAL_REGRESSION_ABC_SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Vectorized accumulation of the sums required by the normal equations, over contiguous float or double arrays.
+// The kernels use GCC / Clang vector extensions. On x86 the AVX2 and AVX-512 versions are selected at runtime
+// depending on the CPU, the portable version uses 16 byte vectors (SSE2 on x86, NEON on ARM).
+// Other compilers, types and non-contiguous data use the scalar code of RegressionAccumulator.
+
+#if defined(__GNUC__)
+#define POLYNOMIAL_REGRESSION_SIMD 1
+#if defined(__x86_64__) || defined(__i386__)
+#define POLYNOMIAL_REGRESSION_SIMD_X86 1
+#endif
+#endif
+
+namespace andviane {
+
+// True if the vectorized kernels can accumulate the values of type T with the internal precision PRECISION.
+  template<typename T, typename PRECISION>
+  constexpr bool is_simd_accumulable =
+#ifdef POLYNOMIAL_REGRESSION_SIMD
+      (std::is_same<PRECISION, float>::value || std::is_same<PRECISION, double>::value) &&
+      (std::is_same<T, float>::value || std::is_same<T, double>::value);
+#else
+      false;
+#endif
+
+// True if the data given by these iterators is accumulated by the vectorized kernels: both are pointers
+// to values that can be accumulated with PRECISION.
+  template<typename ITERATOR_X, typename ITERATOR_Y, typename PRECISION>
+  constexpr bool is_simd_accumulated =
+      std::is_pointer<ITERATOR_X>::value && std::is_pointer<ITERATOR_Y>::value &&
+      is_simd_accumulable<std::remove_cv_t<std::remove_pointer_t<ITERATOR_X>>, PRECISION> &&
+      is_simd_accumulable<std::remove_cv_t<std::remove_pointer_t<ITERATOR_Y>>, PRECISION>;
+
+#ifdef POLYNOMIAL_REGRESSION_SIMD
+
+// Accumulate X[k] += sigma(xi^k), k = 0 .. 2n, Y[k] += sigma(xi^k * yi), k = 0 .. n and YY += sigma(yi^2)
+// using vectors of the given size in bytes. All powers of a block of data points stay in registers, each lane has its own sums.
+  template<int n, int vector_bytes, typename PRECISION, typename TX, typename TY>
+  __attribute__((always_inline)) inline void accumulate_sums_vector(const TX *x, const TY *y, size_t N,
+                                                                    PRECISION *X, PRECISION *Y, PRECISION *YY) {
+    constexpr int lanes = vector_bytes / sizeof(PRECISION);
+    typedef PRECISION vec __attribute__((vector_size(vector_bytes)));
+
+    vec sx[2 * n + 1];
+    vec sy[n + 1];
+    vec syy = vec{} + 0;
+    for (int k = 0; k <= 2 * n; ++k)
+      sx[k] = vec{} + 0;
+    for (int k = 0; k <= n; ++k)
+      sy[k] = vec{} + 0;
+
+    size_t i = 0;
+    for (; i + lanes <= N; i += lanes) {
+      vec xv;
+      vec yv;
+      if constexpr (std::is_same<TX, PRECISION>::value) {
+        memcpy(&xv, x + i, sizeof(vec));
+      } else {
+        for (int l = 0; l < lanes; ++l)
+          xv[l] = (PRECISION) x[i + l];
+      }
+      if constexpr (std::is_same<TY, PRECISION>::value) {
+        memcpy(&yv, y + i, sizeof(vec));
+      } else {
+        for (int l = 0; l < lanes; ++l)
+          yv[l] = (PRECISION) y[i + l];
+      }
+
+      syy += yv * yv;
+      vec xx = vec{} + 1;
+      for (int k = 0; k <= n; ++k) {
+        sx[k] += xx;
+        sy[k] += xx * yv;
+        xx = xx * xv;
+      }
+      for (int k = n + 1; k <= 2 * n; ++k) {
+        sx[k] += xx;
+        xx = xx * xv;
+      }
+    }
+
+    // Sum up the lanes, then the remaining data points.
+    for (int k = 0; k <= 2 * n; ++k)
+      for (int l = 0; l < lanes; ++l)
+        X[k] += sx[k][l];
+    for (int k = 0; k <= n; ++k)
+      for (int l = 0; l < lanes; ++l)
+        Y[k] += sy[k][l];
+    for (int l = 0; l < lanes; ++l)
+      *YY += syy[l];
+
+    for (; i < N; ++i) {
+      PRECISION xi = (PRECISION) x[i];
+      PRECISION yi = (PRECISION) y[i];
+      *YY += yi * yi;
+      PRECISION xx = 1;
+      for (int k = 0; k <= 2 * n; ++k) {
+        X[k] += xx;
+        if (k <= n)
+          Y[k] += xx * yi;
+        xx = xx * xi;
+      }
+    }
+  }
+
+#ifdef POLYNOMIAL_REGRESSION_SIMD_X86
+  template<int n, typename PRECISION, typename TX, typename TY>
+  __attribute__((target("avx512f"))) void accumulate_sums_avx512(const TX *x, const TY *y, size_t N,
+                                                                 PRECISION *X, PRECISION *Y, PRECISION *YY) {
+    accumulate_sums_vector<n, 64>(x, y, N, X, Y, YY);
+  }
+
+  template<int n, typename PRECISION, typename TX, typename TY>
+  __attribute__((target("avx2"))) void accumulate_sums_avx2(const TX *x, const TY *y, size_t N,
+                                                            PRECISION *X, PRECISION *Y, PRECISION *YY) {
+    accumulate_sums_vector<n, 32>(x, y, N, X, Y, YY);
+  }
+#endif
+
+  template<int n, typename PRECISION, typename TX, typename TY>
+  void accumulate_sums_portable(const TX *x, const TY *y, size_t N, PRECISION *X, PRECISION *Y, PRECISION *YY) {
+    accumulate_sums_vector<n, 16>(x, y, N, X, Y, YY);
+  }
+
+// Accumulate X[k] += sigma(xi^k), k = 0 .. 2n, Y[k] += sigma(xi^k * yi), k = 0 .. n and YY += sigma(yi^2)
+// over contiguous arrays, choosing the widest vector kernel supported by this CPU.
+  template<int n, typename PRECISION, typename TX, typename TY>
+  void accumulate_sums(const TX *x, const TY *y, size_t N, PRECISION *X, PRECISION *Y, PRECISION *YY) {
+    static_assert(is_simd_accumulable<TX, PRECISION> && is_simd_accumulable<TY, PRECISION>);
+#ifdef POLYNOMIAL_REGRESSION_SIMD_X86
+    static const bool avx512 = __builtin_cpu_supports("avx512f");
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx512) {
+      accumulate_sums_avx512<n>(x, y, N, X, Y, YY);
+      return;
+    }
+    if (avx2) {
+      accumulate_sums_avx2<n>(x, y, N, X, Y, YY);
+      return;
+    }
+#endif
+    accumulate_sums_portable<n>(x, y, N, X, Y, YY);
+  }
+
+#endif
+}
+#endif
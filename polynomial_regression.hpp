@@ -47,14 +47,53 @@
 #include <cmath>
 #include <array>
 #include <vector>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <functional>
 
 #include "Polynomial.hpp"
+#include "DynamicPolynomial.hpp"
+#include "Polynomial2D.hpp"
+#include "PiecewisePolynomial.hpp"
+#include "RegressionWorkspace.hpp"
+#include "FitStats.hpp"
+#include "StridedView.hpp"
+#include "RegressionAccumulator.hpp"
+#include "SlidingWindowRegression.hpp"
+#include "SavitzkyGolayFilter.hpp"
 #include "internal/polynomial_regression_internals.hpp"
+#include "internal/ChebyshevQr.hpp"
+#include "OrthogonalFit.hpp"
 
 namespace andviane {
 
+// Options of the parallel polynomial regression.
+  struct Parallel {
+    // The number of threads, 0 to use std::thread::hardware_concurrency().
+    unsigned threads = 0;
+
+    // If true, the data points are split into chunks of the same size regardless of the number of threads,
+    // and the sums of chunks are merged in the same order, so the result does not depend on the number of threads.
+    bool reproducible = false;
+  };
+
+// Options of the piecewise polynomial regression.
+  struct PiecewiseOptions {
+    // The number of threads fitting the segments, 0 to use std::thread::hardware_concurrency().
+    unsigned threads = 0;
+
+    // If true, every segment after the first one is constrained to start at the value where the previous
+    // one ends, so the fitted function is continuous. The sums are still accumulated in parallel, only the
+    // small constrained systems are solved one after another.
+    bool continuous = false;
+  };
+
 // Perform polynomial regression over two collections that may have different type but expecting the same size
 // This function only works with containers that provide the size operator.
+// In this and all other functions taking compute_residual, the residual and R^2 are only computed if it is true,
+// from the sums accumulated for the coefficients. Otherwise they are left NaN. Use polynomial_residual for
+// the exact computation in a second pass.
   template<int order, typename TYPE=double, typename PRECISION=TYPE,
       typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
   Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_X &x,
@@ -68,30 +107,277 @@ namespace andviane {
                                                            COLLECTION_Y &y,
                                                            bool compute_residual, size_t size);
 
+// Perform polynomial regression over two collections using multiple threads. Each thread accumulates the sums
+// over its own part of the data, these sums are merged and solved once. Only random access collections are split.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_X &x,
+                                                           const COLLECTION_Y &y,
+                                                           Parallel parallel, bool compute_residual = false);
+
 // Perform polynomial regression over single collection (x simply changes 0 to N)
   template<int order, typename TYPE=double, typename PRECISION=TYPE, typename COLLECTION_Y=std::vector<TYPE>>
   Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_Y &y, bool compute_residual = false);
 
+// Perform polynomial regression over two collections, adding the timings of phases, the data size and
+// the properties of the normal matrix (pivots, condition number) to stats. The residual is always computed.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_X &x, const COLLECTION_Y &y,
+                                                           FitStats &stats);
+
+// Perform polynomial regression over single collection (x simply changes 0 to N), adding to stats.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE, typename COLLECTION_Y=std::vector<TYPE>>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression(const COLLECTION_Y &y, FitStats &stats);
+
+// Filter of samples for polynomial_regression_projected that keeps all of them.
+  struct KeepAll {
+    template<typename SAMPLE>
+    constexpr bool operator()(const SAMPLE &) const {
+      return true;
+    }
+  };
+
+// Perform polynomial regression over a collection of samples (for instance, structs), reading X and Y
+// directly from each sample without copying them into separate collections. projection_x and projection_y
+// may be member pointers (&Sample::timestamp) or callables taking the sample. Samples for which keep returns
+// false are skipped, and so are samples with NaN X or Y if skip_nan is set. The data size of the result is
+// the number of samples used. The values are collected into small blocks, so float or double are still
+// accumulated with vectorized kernels.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE, typename COLLECTION,
+      typename PROJECTION_X, typename PROJECTION_Y, typename FILTER=KeepAll>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression_projected(const COLLECTION &samples,
+                                                                     PROJECTION_X projection_x,
+                                                                     PROJECTION_Y projection_y,
+                                                                     FILTER keep = FILTER(), bool skip_nan = false,
+                                                                     bool compute_residual = false);
+
+// Perform polynomial regression over the samples from first to last, reading X and Y using projections.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR,
+      typename PROJECTION_X, typename PROJECTION_Y, typename FILTER=KeepAll>
+  Polynomial<n, TYPE, PRECISION> polynomial_regression_projected_iter(ITERATOR first, ITERATOR last,
+                                                                      PROJECTION_X projection_x,
+                                                                      PROJECTION_Y projection_y,
+                                                                      FILTER keep = FILTER(),
+                                                                      bool skip_nan = false,
+                                                                      bool compute_residual = false);
+
 // Perform polynomial regression over single collection assuming the fixed sample size (x simply changes 0 to N)
-// Assuming fixed size allows to compute the x_raised matrix only once.
+// Assuming fixed size allows to compute the least squares projection only once, so each fit is just
+// a matrix - vector product.
   template<int order, int fixed_size, typename TYPE=double, typename PRECISION=TYPE, typename COLLECTION_Y=std::vector<TYPE>>
   Polynomial<order, TYPE, PRECISION> polynomial_regression_fixed(const COLLECTION_Y &y, bool compute_residual = false);
 
+// Layout of the matrix holding many Y series for the batch regression.
+  enum class Layout {
+    ROW_MAJOR,    // y[i * series + s] is the value of the series s at x[i]
+    COLUMN_MAJOR  // y[s * N + i] is the value of the series s at x[i]
+  };
+
+// Perform polynomial regression of many Y series against the same X. The normal matrix is built and factorized
+// only once, for every series only the sums of x raised in degree multiplied by y are computed.
+// COLLECTION_YS is a collection of Y collections, each of the same size as X.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_YS=std::vector<std::vector<TYPE>>>
+  std::vector<Polynomial<order, TYPE, PRECISION>> polynomial_regression_batch(const COLLECTION_X &x,
+                                                                              const COLLECTION_YS &ys,
+                                                                              bool compute_residual = false);
+
+// Perform polynomial regression of many Y series, stored in a single matrix, against the same X.
+// With the row major layout, X is walked only once.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X>
+  std::vector<Polynomial<n, TYPE, PRECISION>> polynomial_regression_batch_iter(ITERATOR_X x_iter, const TYPE *y,
+                                                                               size_t N, size_t series,
+                                                                               Layout layout = Layout::ROW_MAJOR,
+                                                                               bool compute_residual = false);
+
+// Perform polynomial regression of many Y series, stored in a single matrix, writing the series results into out.
+// The sums are kept in the workspace, so the fit does not allocate once the workspace is large enough.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X>
+  void polynomial_regression_batch_iter(ITERATOR_X x_iter, const TYPE *y, size_t N, size_t series,
+                                        RegressionWorkspace<PRECISION> &workspace,
+                                        Polynomial<n, TYPE, PRECISION> *out,
+                                        Layout layout = Layout::ROW_MAJOR, bool compute_residual = false);
+
 // Perform polynomial regression using X and Y iterators.
   template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
   Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter,
                                                        ITERATOR_Y y_iter,
                                                        size_t N, bool compute_residual = false);
 
+// Perform polynomial regression using X and Y iterators and multiple threads. Iterators that are not
+// random access are not split, using a single thread.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
+  Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter,
+                                                       ITERATOR_Y y_iter,
+                                                       size_t N, Parallel parallel, bool compute_residual = false);
+
   // Perform polynomial regression Y iterator only (X enumerates 0 to N)
   template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_Y>
   Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_Y y_iter,
                                                        size_t N, bool compute_residual = false);
 
+// Perform polynomial regression using X and Y iterators, adding to stats.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
+  Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                                            FitStats &stats);
+
+// Perform polynomial regression using Y iterator only (X enumerates 0 to N), adding to stats.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_Y>
+  Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_Y y_iter, size_t N, FitStats &stats);
+
 // Perform polynomial regression using Y iterator only (X enumerates 0 to N assuming the fixed sample size)
   template<int n, int fixed_size, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_Y>
   Polynomial<n, TYPE, PRECISION> polynomial_regression_iter(ITERATOR_Y y_iter, bool compute_residual = false);
 
+// Perform numerically stable polynomial regression, allowing high orders (10 - 30) with PRECISION = double.
+// X is centered and scaled into [-1, 1], the least squares problem is solved by QR factorization in the
+// Chebyshev basis, and the result is converted back into the coefficients of x. Needs two passes over X
+// (the first one finds the range). Note that monomial coefficients of high orders may still be large
+// and cancel each other if X is far from zero.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  Polynomial<order, TYPE, PRECISION> polynomial_regression_stable(const COLLECTION_X &x,
+                                                                  const COLLECTION_Y &y,
+                                                                  bool compute_residual = false);
+
+// Perform numerically stable polynomial regression using X and Y iterators.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
+  Polynomial<n, TYPE, PRECISION> polynomial_regression_stable_iter(ITERATOR_X x_iter,
+                                                              ITERATOR_Y y_iter,
+                                                              size_t N, bool compute_residual = false);
+
+// Fit polynomials of every degree 0 .. order from a single factorization, to compare residuals or select the degree
+// automatically. Uses the same numerically stable approach as polynomial_regression_stable, so it also needs
+// two passes over X (the first one finds the range).
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  OrthogonalFit<order, TYPE, PRECISION> polynomial_regression_all(const COLLECTION_X &x, const COLLECTION_Y &y);
+
+// Fit polynomials of every degree 0 .. n using X and Y iterators. X is read twice, so it cannot be a single pass
+// input iterator.
+  template<int n, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
+  OrthogonalFit<n, TYPE, PRECISION> polynomial_regression_all_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N);
+
+// Perform polynomial regression over two collections in the FAST precision first, checking the pivots, the
+// condition number of the normal matrix and the sanity of the residual. If the estimated relative error of
+// coefficients (condition number times the machine epsilon of FAST) exceeds tolerance, or the result is not
+// sane, the fit is repeated in WIDE precision. Polynomial::precision_digits tells which precision was used.
+// Collections (or iterators) are traversed twice if the fit is repeated.
+  template<int order, typename TYPE=double, typename FAST=double, typename WIDE=long double,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  Polynomial<order, TYPE, WIDE> polynomial_regression_escalating(const COLLECTION_X &x, const COLLECTION_Y &y,
+                                                                 double tolerance = 1E-6);
+
+// Perform polynomial regression over single collection (x simply changes 0 to N), escalating the precision
+// if required.
+  template<int order, typename TYPE=double, typename FAST=double, typename WIDE=long double,
+      typename COLLECTION_Y=std::vector<TYPE>>
+  Polynomial<order, TYPE, WIDE> polynomial_regression_escalating(const COLLECTION_Y &y, double tolerance = 1E-6);
+
+// Perform polynomial regression using X and Y forward iterators, escalating the precision if required.
+  template<int n, typename TYPE=double, typename FAST=double, typename WIDE=long double,
+      typename ITERATOR_X, typename ITERATOR_Y>
+  Polynomial<n, TYPE, WIDE> polynomial_regression_escalating_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                                                  double tolerance = 1E-6);
+
+// Perform polynomial surface regression z = f(x, y) of the total degree over three collections of the same size.
+// The moments sigma(xi^p * yi^q) are accumulated in a single pass, sharing the powers of x and y between them.
+  template<int degree, typename TYPE=double, typename PRECISION=TYPE, typename COLLECTION_X=std::vector<TYPE>,
+      typename COLLECTION_Y=std::vector<TYPE>, typename COLLECTION_Z=std::vector<TYPE>>
+  Polynomial2D<degree, TYPE, PRECISION> polynomial_regression_2d(const COLLECTION_X &x, const COLLECTION_Y &y,
+                                                                 const COLLECTION_Z &z);
+
+// Perform polynomial surface regression z = f(x, y) of the total degree d using X, Y and Z iterators.
+  template<int d, typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y,
+      typename ITERATOR_Z>
+  Polynomial2D<d, TYPE, PRECISION> polynomial_regression_2d_iter(ITERATOR_X x_iter, ITERATOR_Y y_iter,
+                                                                 ITERATOR_Z z_iter, size_t N);
+
+// Perform piecewise polynomial regression over two random access collections, X sorted in ascending order.
+// knots are the increasing boundaries of segments, data points outside them are not used. Every segment is
+// fitted separately in the coordinate local to its start, segments in parallel. Every segment must have at
+// least order + 1 data points.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  PiecewisePolynomial<order, TYPE, PRECISION> polynomial_regression_piecewise(const COLLECTION_X &x,
+                                                                              const COLLECTION_Y &y,
+                                                                              const std::vector<PRECISION> &knots,
+                                                                              PiecewiseOptions options = {});
+
+// Perform piecewise polynomial regression over the given number of segments of equal width between
+// the first and the last X.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  PiecewisePolynomial<order, TYPE, PRECISION> polynomial_regression_piecewise(const COLLECTION_X &x,
+                                                                              const COLLECTION_Y &y,
+                                                                              size_t segments,
+                                                                              PiecewiseOptions options = {});
+
+// Perform piecewise polynomial regression choosing the segments adaptively. Starting from a single segment,
+// every segment where the average squared residual exceeds tolerance is split into halves with the same number
+// of data points, as long as both have at least min_points (no less than order + 1). All segments of the same
+// level are fitted in parallel.
+  template<int order, typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  PiecewisePolynomial<order, TYPE, PRECISION> polynomial_regression_piecewise_adaptive(const COLLECTION_X &x,
+                                                                                       const COLLECTION_Y &y,
+                                                                                       PRECISION tolerance,
+                                                                                       size_t min_points,
+                                                                                       PiecewiseOptions options = {});
+
+// Perform polynomial regression of the order given at runtime over two collections of the same size.
+// Serving many orders does not require instantiating templates for each of them.
+  template<typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic(int order, const COLLECTION_X &x,
+                                                                   const COLLECTION_Y &y,
+                                                                   bool compute_residual = false);
+
+// Perform polynomial regression of the order given at runtime using X and Y iterators.
+  template<typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
+  DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic_iter(int order, ITERATOR_X x_iter,
+                                                                        ITERATOR_Y y_iter, size_t N,
+                                                                        bool compute_residual = false);
+
+// Perform polynomial regression of the order given at runtime over two collections, adding to stats.
+  template<typename TYPE=double, typename PRECISION=TYPE,
+      typename COLLECTION_X=std::vector<TYPE>, typename COLLECTION_Y=std::vector<TYPE>>
+  DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic(int order, const COLLECTION_X &x,
+                                                                   const COLLECTION_Y &y, FitStats &stats);
+
+// Perform polynomial regression of the order given at runtime using X and Y iterators, adding to stats.
+  template<typename TYPE=double, typename PRECISION=TYPE, typename ITERATOR_X, typename ITERATOR_Y>
+  DynamicPolynomial<TYPE, PRECISION> polynomial_regression_dynamic_iter(int order, ITERATOR_X x_iter,
+                                                                        ITERATOR_Y y_iter, size_t N,
+                                                                        FitStats &stats);
+
+// Perform polynomial regression of the order given at runtime over two collections, writing into result.
+// Scratch buffers are taken from the workspace, and the storage of result is reused, so repeated fits
+// do not allocate once the workspace and result are large enough.
+  template<typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+  void polynomial_regression_dynamic(int order, const COLLECTION_X &x, const COLLECTION_Y &y,
+                                     RegressionWorkspace<PRECISION> &workspace,
+                                     DynamicPolynomial<TYPE, PRECISION> &result, bool compute_residual = false);
+
+// Perform polynomial regression of the order given at runtime using X and Y iterators, writing into result.
+  template<typename TYPE, typename PRECISION, typename ITERATOR_X, typename ITERATOR_Y>
+  void polynomial_regression_dynamic_iter(int order, ITERATOR_X x_iter, ITERATOR_Y y_iter, size_t N,
+                                          RegressionWorkspace<PRECISION> &workspace,
+                                          DynamicPolynomial<TYPE, PRECISION> &result,
+                                          bool compute_residual = false);
+
+// Compute the residual and R^2 of the polynomial exactly, in a second pass over the data, storing them in
+// the polynomial. Regression functions compute the residual from the sums accumulated in the same pass; this
+// is faster but may lose precision to cancellation if the fit is very close.
+  template<int order, typename TYPE, typename PRECISION, typename COLLECTION_X, typename COLLECTION_Y>
+  void polynomial_residual(Polynomial<order, TYPE, PRECISION> &polynomial, const COLLECTION_X &x,
+                           const COLLECTION_Y &y);
+
+// Compute the residual and R^2 exactly, in a second pass over Y (X enumerates 0 to N).
+  template<int order, typename TYPE, typename PRECISION, typename COLLECTION_Y>
+  void polynomial_residual(Polynomial<order, TYPE, PRECISION> &polynomial, const COLLECTION_Y &y);
+
 #include "internal/polynomial_regression_internals.tpp"
 }
 #endif
@@ -0,0 +1,185 @@
+#include <limits>
+#include <sstream>
+#include <iterator>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Quadratic, adding points one by one
+TEST(Accumulator, n2) {
+  // y = f(x) = ax^2 + bx + c
+  double a = 2;
+  double b = 3;
+  double c = 4;
+
+  RegressionAccumulator<2> accumulator;
+  for (int xx = -10; xx < 10; xx++) {
+    accumulator.add(xx, a * xx * xx + b * xx + c);
+  }
+
+  ASSERT_EQ(accumulator.size(), 20);
+
+  Polynomial<2> p = accumulator.solve();
+
+  ASSERT_EQ(p.data_size(), 20);
+  ASSERT_FLOAT_EQ(p[0], c);
+  ASSERT_FLOAT_EQ(p[1], b);
+  ASSERT_FLOAT_EQ(p[2], a);
+}
+
+// Must give exactly the same result as polynomial_regression
+TEST(Accumulator, same_as_regression) {
+  std::vector<float> x;
+  std::vector<float> y;
+
+  for (int xx = -20; xx < 20; xx++) {
+    x.push_back(xx * 0.1f);
+    y.push_back(std::sin(xx * 0.1f));
+  }
+
+  RegressionAccumulator<3, float, double> accumulator;
+  accumulator.add(x.data(), y.data(), x.size());
+
+  auto expected = polynomial_regression<3, float, double>(x, y);
+  auto p = accumulator.solve();
+
+  for (int i = 0; i <= 3; i++) {
+    ASSERT_EQ(p[i], expected[i]);
+  }
+}
+
+// True single pass input iterators
+TEST(Accumulator, input_iterator) {
+  // y = f(x) = ax + c
+  std::istringstream xs("0 1 2 3 4 5");
+  std::istringstream ys("4 6 8 10 12 14");
+
+  RegressionAccumulator<1> accumulator;
+  accumulator.add(std::istream_iterator<double>(xs), std::istream_iterator<double>(ys), 6);
+
+  Polynomial<1> p = accumulator.solve();
+
+  ASSERT_FLOAT_EQ(p[0], 4);
+  ASSERT_FLOAT_EQ(p[1], 2);
+
+  accumulator.clear();
+  ASSERT_EQ(accumulator.size(), 0);
+}
+
+// Vectorized accumulation over pointers against the scalar one over iterators
+TEST(Accumulator, vectorized) {
+  for (int N: {1, 7, 33, 1001}) {
+    std::vector<float> x;
+    std::vector<double> y;
+
+    for (int i = 0; i < N; i++) {
+      x.push_back(2.0f * i / N - 1);
+      y.push_back(std::exp(x.back()));
+    }
+
+    RegressionAccumulator<4, double> vectorized;
+    vectorized.add(x.data(), y.data(), N);
+
+    RegressionAccumulator<4, double> scalar;
+    scalar.add(x.cbegin(), y.cbegin(), N);
+
+    ASSERT_EQ(vectorized.size(), N);
+
+    if (N > 4) {
+      auto expected = scalar.solve();
+      auto p = vectorized.solve();
+      for (int k = 0; k <= 4; k++) {
+        ASSERT_NEAR(p[k], expected[k], 1E-7);
+      }
+    }
+  }
+}
+
+// Shards fit locally, ship serialized sums, the coordinator merges them
+TEST(Accumulator, merge_serialize) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 300; i++) {
+    x.push_back(i * 0.01);
+    y.push_back(std::exp(i * 0.01));
+  }
+
+  std::vector<std::vector<uint8_t>> shipped;
+  for (int shard = 0; shard < 3; shard++) {
+    RegressionAccumulator<3> local;
+    local.add(x.cbegin() + shard * 100, y.cbegin() + shard * 100, 100);
+    shipped.push_back(local.serialize());
+  }
+  ASSERT_EQ(shipped[0].size(), 16 + (7 + 4 + 1) * sizeof(double));
+
+  RegressionAccumulator<3> coordinator;
+  RegressionAccumulator<3> last;
+  for (const auto &data: shipped) {
+    RegressionAccumulator<3> shard;
+    ASSERT_TRUE(shard.deserialize(data));
+    coordinator.merge(shard);
+    last = shard;
+  }
+  ASSERT_EQ(coordinator.size(), 300);
+
+  auto expected = polynomial_regression<3>(x, y);
+  auto p = coordinator.solve();
+  for (int k = 0; k <= 3; k++) {
+    ASSERT_NEAR(p[k], expected[k], 1E-9);
+  }
+
+  // Remove the contribution of the last shard
+  coordinator.retract(last);
+  std::vector<double> x2(x.begin(), x.begin() + 200);
+  std::vector<double> y2(y.begin(), y.begin() + 200);
+  expected = polynomial_regression<3>(x2, y2, true);
+  p = coordinator.solve();
+  for (int k = 0; k <= 3; k++) {
+    ASSERT_NEAR(p[k], expected[k], 1E-9);
+  }
+}
+
+// Invalid data must be rejected
+TEST(Accumulator, deserialize_invalid) {
+  RegressionAccumulator<2> accumulator;
+  accumulator.add(1, 2);
+  std::vector<uint8_t> data = accumulator.serialize();
+
+  RegressionAccumulator<3> other_order;
+  ASSERT_FALSE(other_order.deserialize(data));
+
+  RegressionAccumulator<2, float> other_precision;
+  ASSERT_FALSE(other_precision.deserialize(data));
+
+  RegressionAccumulator<2> truncated;
+  ASSERT_FALSE(truncated.deserialize(data.data(), data.size() - 1));
+
+  data[0] = 'X';
+  ASSERT_FALSE(truncated.deserialize(data));
+  ASSERT_EQ(truncated.size(), 0);
+}
+
+// Serialized long double does not depend on the padding bytes of the values
+TEST(Accumulator, serialize_long_double) {
+  RegressionAccumulator<2, double, long double> accumulator;
+  for (int i = 0; i < 10; i++) {
+    accumulator.add(i, 1 + 0.5 * i * i);
+  }
+  std::vector<uint8_t> data = accumulator.serialize();
+
+  // Fill the padding with ones, read them into the sums and serialize again
+  std::vector<uint8_t> dirty = data;
+  const size_t header = 4 + 1 + 2 + 1 + 8;
+  const size_t value_bytes = std::numeric_limits<long double>::digits == 64 ? 10 : sizeof(long double);
+  for (size_t at = header; at < dirty.size(); at += sizeof(long double)) {
+    for (size_t i = value_bytes; i < sizeof(long double); i++) {
+      ASSERT_EQ(dirty[at + i], 0);
+      dirty[at + i] = 0xFF;
+    }
+  }
+  RegressionAccumulator<2, double, long double> restored;
+  ASSERT_TRUE(restored.deserialize(dirty));
+  ASSERT_EQ(restored.serialize(), data);
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+namespace {
+  struct Sample {
+    double timestamp;
+    float value;
+    int flags;
+  };
+
+  std::vector<Sample> make_samples(int count) {
+    std::vector<Sample> samples;
+    for (int i = 0; i < count; i++) {
+      double t = i * 0.01;
+      samples.push_back({t, (float) (1 + 2 * t - 0.5 * t * t), 0});
+    }
+    return samples;
+  }
+}
+
+#if __cplusplus >= 202002L
+static_assert(std::random_access_iterator<StridedIterator<double>>);
+#endif
+
+// Strided iterators work with standard algorithms and reverse iteration
+TEST(Adapters, strided_iterator) {
+  std::vector<Sample> samples = make_samples(100);
+  StridedView<double> x(&samples[0].timestamp, samples.size(), sizeof(Sample));
+  auto first = x.cbegin();
+  auto last = x.cend();
+  ASSERT_TRUE(first < last && last > first && first <= first && last >= first);
+  ASSERT_EQ(2 + first, first + 2);
+  ASSERT_EQ(std::lower_bound(first, last, 0.5) - first, 50);
+  ASSERT_EQ(std::distance(first, last), 100);
+
+  auto at = last;
+  auto was = at--;
+  ASSERT_EQ(was, last);
+  ASSERT_EQ(*at, samples[99].timestamp);
+  ASSERT_EQ(at.operator->(), &samples[99].timestamp);
+
+  std::reverse_iterator<StridedIterator<double>> reversed(last);
+  ASSERT_EQ(*reversed, samples[99].timestamp);
+  ASSERT_EQ(reversed[99], samples[0].timestamp);
+}
+
+// Strided views read members of structs in place
+TEST(Adapters, strided) {
+  std::vector<Sample> samples = make_samples(1000);
+  StridedView<double> x(&samples[0].timestamp, samples.size(), sizeof(Sample));
+  StridedView<float> y(&samples[0].value, samples.size(), sizeof(Sample));
+  ASSERT_EQ(x[10], samples[10].timestamp);
+  ASSERT_EQ(y.cend() - y.cbegin(), 1000);
+
+  std::vector<double> xv;
+  std::vector<double> yv;
+  for (const Sample &s: samples) {
+    xv.push_back(s.timestamp);
+    yv.push_back(s.value);
+  }
+
+  auto p = polynomial_regression<2>(x, y);
+  auto expected = polynomial_regression<2>(xv, yv);
+  for (int k = 0; k <= 2; k++) {
+    ASSERT_NEAR(p[k], expected[k], 1E-6);
+  }
+
+  // Random access views can be split between threads
+  auto parallel = polynomial_regression<2>(x, y, Parallel{4});
+  ASSERT_NEAR(parallel[2], -0.5, 1E-4);
+}
+
+// Timestamps far from zero keep the precision of the slope
+TEST(Adapters, projected_timestamps) {
+  std::vector<Sample> samples;
+  for (int i = 0; i < 1000; i++)
+    samples.push_back({1.7E9 + i, (float) (3 - 0.5 * i), i % 10 == 0});
+
+  auto p = polynomial_regression_projected<1>(samples, &Sample::timestamp, &Sample::value, KeepAll(), false, true);
+  ASSERT_NEAR(p[1], -0.5, 1E-9);
+  ASSERT_NEAR(p(1.7E9 + 10), -2, 1E-6);
+  ASSERT_NEAR(p.residual(), 0, 1E-9);
+
+  auto keep = [](const Sample &s) { return s.flags == 0; };
+  auto parabola = polynomial_regression_projected<2>(samples, &Sample::timestamp, &Sample::value, keep);
+  ASSERT_EQ(parabola.data_size(), 900);
+  ASSERT_NEAR(parabola[1], -0.5, 1E-6);
+  ASSERT_TRUE(std::isnan(parabola.residual()));
+}
+
+// Projections read X and Y from samples, skipping flagged and NaN ones
+TEST(Adapters, projected) {
+  std::vector<Sample> samples = make_samples(1000);
+  auto p = polynomial_regression_projected<2>(samples, &Sample::timestamp, &Sample::value);
+  ASSERT_EQ(p.data_size(), 1000);
+  ASSERT_NEAR(p[0], 1, 1E-5);
+  ASSERT_NEAR(p[1], 2, 1E-5);
+  ASSERT_NEAR(p[2], -0.5, 1E-5);
+
+  for (int i = 0; i < 1000; i += 7) {
+    samples[i].value = 1000;
+    samples[i].flags = 1;
+  }
+  samples[500].value = NAN;
+
+  auto keep = [](const Sample &s) { return s.flags == 0; };
+  auto filtered = polynomial_regression_projected<2>(samples, &Sample::timestamp, &Sample::value, keep, true);
+  ASSERT_EQ(filtered.data_size(), 1000 - 143 - 1);
+  ASSERT_NEAR(filtered[0], 1, 1E-5);
+  ASSERT_NEAR(filtered[2], -0.5, 1E-5);
+
+  // Callables work as projections, also over non contiguous collections
+  std::deque<Sample> deque(samples.begin(), samples.end());
+  auto scaled = polynomial_regression_projected<1>(deque, [](const Sample &s) { return 2 * s.timestamp; },
+                                                   [](const Sample &s) { return (double) s.flags; });
+  ASSERT_EQ(scaled.data_size(), 1000);
+}
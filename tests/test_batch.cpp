@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Many series against the same X, each series must match the individual fit
+TEST(Batch, n2_collections) {
+  std::vector<double> x;
+  std::vector<std::vector<double>> ys(5);
+
+  for (int xx = -10; xx < 10; xx++) {
+    x.push_back(xx);
+    for (int s = 0; s < 5; s++) {
+      ys[s].push_back((s + 1) * xx * xx - s * xx + 4 + std::sin(xx * s));
+    }
+  }
+
+  auto batch = polynomial_regression_batch<2>(x, ys, true);
+  ASSERT_EQ(batch.size(), 5);
+
+  for (int s = 0; s < 5; s++) {
+    auto expected = polynomial_regression<2>(x, ys[s], true);
+    for (int k = 0; k <= 2; k++) {
+      ASSERT_FLOAT_EQ(batch[s][k], expected[k]);
+    }
+    ASSERT_FLOAT_EQ(batch[s].residual(), expected.residual());
+  }
+}
+
+// The same series stored as a single matrix in both layouts
+TEST(Batch, n3_matrix) {
+  constexpr int N = 30;
+  constexpr int series = 4;
+
+  std::vector<float> x;
+  std::vector<float> row_major(N * series);
+  std::vector<float> column_major(N * series);
+  std::vector<std::vector<float>> ys(series);
+
+  for (int i = 0; i < N; i++) {
+    float xx = i * 0.1f;
+    x.push_back(xx);
+    for (int s = 0; s < series; s++) {
+      float yy = std::cos(xx + s);
+      row_major[i * series + s] = yy;
+      column_major[s * N + i] = yy;
+      ys[s].push_back(yy);
+    }
+  }
+
+  auto by_rows = polynomial_regression_batch_iter<3, float, double>(x.cbegin(), row_major.data(), N, series);
+  auto by_columns = polynomial_regression_batch_iter<3, float, double>(x.cbegin(), column_major.data(), N, series,
+                                                                       Layout::COLUMN_MAJOR);
+
+  for (int s = 0; s < series; s++) {
+    auto expected = polynomial_regression<3, float, double>(x, ys[s]);
+    for (int k = 0; k <= 3; k++) {
+      ASSERT_FLOAT_EQ(by_rows[s][k], expected[k]);
+      ASSERT_FLOAT_EQ(by_columns[s][k], expected[k]);
+    }
+  }
+}
@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <string>
+#include "gtest/gtest.h"
+
+#include "CsvRegression.hpp"
+
+using namespace andviane;
+
+namespace {
+  std::string write_text(const std::string &name, const std::string &text) {
+    std::string path = testing::TempDir() + name;
+    FILE *file = fopen(path.c_str(), "wb");
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+    return path;
+  }
+}
+
+// Many small blocks and chunks give the same fit as vectors
+TEST(Csv, chunks) {
+  std::string text = "time,flags,value\n";
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 10000; i++) {
+    x.push_back(i * 0.001);
+    y.push_back(1 + 2 * x.back() - 0.5 * x.back() * x.back());
+    char row[100];
+    snprintf(row, sizeof(row), "%.17g,0,%.17g\r\n", x.back(), y.back());
+    text += row;
+  }
+  std::string path = write_text("csv_chunks.csv", text);
+
+  CsvOptions options;
+  options.y_column = 2;
+  options.skip_lines = 1;
+  options.chunk_size = 100;
+  options.block_size = 7;
+  options.queue_blocks = 2;
+  Polynomial<2> p;
+  CsvRows rows;
+  ASSERT_TRUE(polynomial_regression_csv(path, p, options, &rows));
+  ASSERT_EQ(rows.parsed, 10000);
+  ASSERT_EQ(rows.skipped, 0);
+
+  auto expected = polynomial_regression<2>(x, y);
+  for (int k = 0; k <= 2; k++) {
+    ASSERT_NEAR(p[k], expected[k], 1E-9);
+  }
+}
+
+// X as seconds since the epoch keeps the precision of the slope
+TEST(Csv, epoch_time) {
+  std::string text;
+  for (int i = 0; i < 1000; i++) {
+    char row[100];
+    snprintf(row, sizeof(row), "%d,%.17g\n", 1700000000 + i, 3 - 0.5 * i);
+    text += row;
+  }
+  std::string path = write_text("csv_epoch.csv", text);
+
+  CsvOptions options;
+  options.block_size = 100;
+  Polynomial<1> line;
+  ASSERT_TRUE(polynomial_regression_csv(path, line, options));
+  ASSERT_NEAR(line[1], -0.5, 1E-9);
+  ASSERT_NEAR(line(1700000010.0), -2, 1E-6);
+  ASSERT_NEAR(line.residual(), 0, 1E-9);
+
+  Polynomial<2> parabola;
+  ASSERT_TRUE(polynomial_regression_csv(path, parabola, options));
+  ASSERT_NEAR(parabola[1], -0.5, 1E-6);
+}
+
+// Rows that cannot be parsed and lines longer than the chunk are skipped
+TEST(Csv, skipped) {
+  std::string text = "0; 1\n"
+                     "1; \"3\"\n"
+                     "x; 4\n"
+                     "\n"
+                     "2;5\n"
+                     "3\n" +
+                     std::string(200, '9') + "\n"
+                     "3;+7";
+  std::string path = write_text("csv_skipped.csv", text);
+
+  CsvOptions options;
+  options.delimiter = ';';
+  options.chunk_size = 64;
+  Polynomial<1> p;
+  CsvRows rows;
+  ASSERT_TRUE(polynomial_regression_csv(path, p, options, &rows));
+  ASSERT_EQ(rows.parsed, 4);
+  ASSERT_EQ(rows.skipped, 3);
+  ASSERT_NEAR(p[0], 1, 1E-12);
+  ASSERT_NEAR(p[1], 2, 1E-12);
+
+  // X enumerating the rows, the row with bad X is now used
+  options.x_column = -1;
+  ASSERT_TRUE(polynomial_regression_csv(path, p, options, &rows));
+  ASSERT_EQ(rows.parsed, 5);
+  ASSERT_EQ(rows.skipped, 2);
+  ASSERT_EQ(p.data_size(), 5);
+
+  ASSERT_FALSE(polynomial_regression_csv(testing::TempDir() + "csv_missing.csv", p));
+}
@@ -46,4 +46,30 @@ TEST(Integrate, n2) {
   ASSERT_FLOAT_EQ(integral[3], p[2]/3.0);
 
   ASSERT_FLOAT_EQ(integral(0.5), 2.458333333);
-}
\ No newline at end of file
+}
+
+TEST(Differentiate, n2_batch) {
+  Polynomial p = make_polynomial();
+  Polynomial derivative = p.differentiate();
+
+  std::vector<double> x = {-3, -0.5, 0, 0.5, 7};
+  std::vector<double> values(x.size());
+  p.evaluate_derivative(x.data(), values.data(), x.size());
+
+  for (int i = 0; i < x.size(); i++) {
+    ASSERT_FLOAT_EQ(values[i], derivative(x[i]));
+  }
+}
+
+TEST(Integrate, n2_batch) {
+  Polynomial p = make_polynomial();
+  Polynomial integral = p.integrate(3);
+
+  std::vector<double> x = {-3, -0.5, 0, 0.5, 7};
+  std::vector<double> values(x.size());
+  p.evaluate_integral(x.data(), values.data(), x.size(), 3);
+
+  for (int i = 0; i < x.size(); i++) {
+    ASSERT_FLOAT_EQ(values[i], integral(x[i]));
+  }
+}
@@ -0,0 +1,99 @@
+#include <list>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Runtime order regression must match the fixed order one
+TEST(Dynamic, same_as_fixed) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 300; i++) {
+    double xx = i * 0.01 - 1.5;
+    x.push_back(xx);
+    y.push_back(std::exp(xx) * std::sin(2 * xx));
+  }
+
+  auto fixed = polynomial_regression<4>(x, y, true);
+  auto dynamic = polynomial_regression_dynamic(4, x, y, true);
+  ASSERT_EQ(dynamic.order(), 4);
+  ASSERT_EQ(dynamic.data_size(), 300);
+  for (int k = 0; k <= 4; k++) {
+    ASSERT_NEAR(dynamic[k], fixed[k], 1E-9);
+  }
+  ASSERT_NEAR(dynamic.residual(), fixed.residual(), 1E-9);
+  ASSERT_NEAR(dynamic.r_squared(), fixed.r_squared(), 1E-12);
+
+  std::vector<double> expected(x.size());
+  std::vector<double> values(x.size());
+  fixed.evaluate(x.data(), expected.data(), x.size());
+  dynamic.evaluate(x.data(), values.data(), x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    ASSERT_NEAR(values[i], expected[i], 1E-9);
+    ASSERT_NEAR(dynamic(x[i]), values[i], 1E-12);
+  }
+
+  // Conversion from the fixed order polynomial
+  DynamicPolynomial<double> converted = fixed;
+  ASSERT_EQ(converted.order(), 4);
+  ASSERT_EQ(converted[3], fixed[3]);
+  ASSERT_EQ(converted.residual(), fixed.residual());
+}
+
+// Orders above the inline capacity use the heap, differentiation and integration work at any order
+TEST(Dynamic, orders) {
+  std::list<float> x;
+  std::list<float> y;
+  for (int i = 0; i < 100; i++) {
+    float xx = i * 0.02f - 1;
+    x.push_back(xx);
+    y.push_back(3 * xx * xx - xx + 2);
+  }
+
+  for (int order = 0; order <= 3; order++) {
+    auto p = polynomial_regression_dynamic<float, double>(order, x, y, true);
+    ASSERT_EQ(p.order(), order);
+    if (order >= 2) {
+      ASSERT_NEAR(p[0], 2, 1E-6);
+      ASSERT_NEAR(p[1], -1, 1E-6);
+      ASSERT_NEAR(p[2], 3, 1E-6);
+      ASSERT_NEAR(p.residual(), 0, 1E-6);
+    }
+  }
+
+  DynamicPolynomial<double> large(20);
+  large[20] = 1;
+  auto diff = large.differentiate();
+  ASSERT_EQ(diff.order(), 19);
+  ASSERT_EQ(diff[19], 20);
+  auto integ = diff.integrate(5);
+  ASSERT_EQ(integ.order(), 20);
+  ASSERT_EQ(integ[20], 1);
+  ASSERT_EQ(integ[0], 5);
+  ASSERT_NEAR(integ(2.0), 5 + std::pow(2.0, 20), 1E-6);
+}
+
+// Batch derivative and integral agree with the constructed polynomials, also above the inline capacity
+TEST(Dynamic, evaluate_derivative_integral) {
+  std::vector<double> xs;
+  for (int i = 0; i < 300; i++)
+    xs.push_back(i * 0.007 - 1);
+  std::vector<double> out(xs.size());
+
+  for (int order: {0, 3, 20}) {
+    DynamicPolynomial<double> p(order);
+    for (int k = 0; k <= order; k++)
+      p[k] = 1.0 / (k + 1) - 0.1 * k;
+
+    p.evaluate_derivative(xs.data(), out.data(), xs.size());
+    DynamicPolynomial<double> diff = p.differentiate();
+    for (size_t i = 0; i < xs.size(); i++)
+      ASSERT_NEAR(out[i], diff(xs[i]), 1E-12);
+
+    p.evaluate_integral(xs.data(), out.data(), xs.size(), 2);
+    DynamicPolynomial<double> integ = p.integrate(2);
+    for (size_t i = 0; i < xs.size(); i++)
+      ASSERT_NEAR(out[i], integ(xs[i]), 1E-12);
+  }
+}
@@ -0,0 +1,61 @@
+#include <deque>
+#include <limits>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Well conditioned fit stays in double
+TEST(Escalation, fast) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 1000; i++) {
+    double xx = i * 0.002 - 1;
+    x.push_back(xx);
+    y.push_back(1 + 2 * xx - 3 * xx * xx);
+  }
+
+  auto p = polynomial_regression_escalating<2>(x, y);
+  auto expected = polynomial_regression<2>(x, y, true);
+  ASSERT_EQ(p.precision_digits(), std::numeric_limits<double>::digits);
+  for (int k = 0; k <= 2; k++) {
+    ASSERT_EQ(p[k], expected[k]);
+  }
+  ASSERT_EQ(p.residual(), expected.residual());
+  ASSERT_EQ(p.data_size(), 1000);
+}
+
+// Ill conditioned fit is repeated in long double, giving the same result as the long double fit
+TEST(Escalation, wide) {
+  std::deque<double> y;
+  for (int i = 0; i < 2000; i++) {
+    y.push_back(0.5 * i - 1E-3 * i * i + 1E-7 * i * i * i);
+  }
+
+  auto p = polynomial_regression_escalating<3>(y);
+  auto expected = polynomial_regression<3, double, long double>(y, true);
+  ASSERT_EQ(p.precision_digits(), std::numeric_limits<long double>::digits);
+  for (int k = 0; k <= 3; k++) {
+    ASSERT_EQ(p[k], expected[k]);
+  }
+
+  // With a loose tolerance, double is accepted for the lower order.
+  auto loose = polynomial_regression_escalating<2>(y, 1E-2);
+  ASSERT_EQ(loose.precision_digits(), std::numeric_limits<double>::digits);
+  ASSERT_EQ(polynomial_regression_escalating<2>(y).precision_digits(), std::numeric_limits<long double>::digits);
+}
+
+// Iterators are walked again when escalating
+TEST(Escalation, iterators) {
+  std::vector<float> x;
+  std::vector<float> y;
+  for (int i = 0; i < 500; i++) {
+    x.push_back(1000 + i);
+    y.push_back(2 * i + 1);
+  }
+
+  auto p = polynomial_regression_escalating_iter<2, float, float, double>(x.cbegin(), y.cbegin(), x.size());
+  ASSERT_EQ(p.precision_digits(), std::numeric_limits<double>::digits);
+  ASSERT_NEAR(p(1200), 401, 1E-2);
+}
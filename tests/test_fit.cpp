@@ -1,4 +1,5 @@
 #include <deque>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "polynomial_regression.hpp"
@@ -70,6 +71,48 @@ TEST(Fit, n1_residual) {
   ASSERT_FLOAT_EQ(p.residual(), 10.0); // 40 points, 0.25 squared deviation each.
 }
 
+// Residual from the sums against the exact second pass
+TEST(Fit, n2_residual_r_squared) {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  for (int xx = -50; xx < 50; xx++) {
+    x.push_back(xx * 0.1);
+    y.push_back(std::cos(xx * 0.1));
+  }
+
+  auto p = polynomial_regression<2>(x, y, true);
+  auto exact = p;
+  polynomial_residual(exact, x, y);
+
+  ASSERT_NEAR(p.residual(), exact.residual(), 1E-9);
+  ASSERT_NEAR(p.r_squared(), exact.r_squared(), 1E-9);
+  ASSERT_NEAR(p.avg_sqdif(), exact.residual() / 100, 1E-9);
+  ASSERT_GT(p.r_squared(), 0);
+  ASSERT_LT(p.r_squared(), 1);
+
+  // X enumerated
+  auto q = polynomial_regression<2>(y, true);
+  auto q_exact = q;
+  polynomial_residual(q_exact, y);
+  ASSERT_NEAR(q.residual(), q_exact.residual(), 1E-9);
+  ASSERT_NEAR(q.r_squared(), q_exact.r_squared(), 1E-9);
+}
+
+// The residual is not distorted by rounding to the integral type
+TEST(Fit, n1_residual_int) {
+  std::vector<uint8_t> x = {0, 1, 2, 3};
+  std::vector<uint8_t> y = {0, 1, 1, 2};
+
+  auto p = polynomial_regression<1, uint8_t, double>(x, y, true);
+  auto exact = p;
+  polynomial_residual(exact, x, y);
+
+  // y = 0.1 + 0.6 x
+  ASSERT_NEAR(p.residual(), 0.2, 1E-12);
+  ASSERT_NEAR(exact.residual(), 0.2, 1E-12);
+}
+
 // Quadratic
 TEST(Fit, n2) {
   // y = f(x) = ax^2 + bx + c
@@ -112,6 +155,27 @@ TEST(Fit, n2_single_vector) {
   ASSERT_FLOAT_EQ(p[2], a);
 }
 
+// Closed form sums of X enumerating 0 to N - 1
+TEST(Fit, enumerated_power_sums) {
+  for (size_t N: {1, 2, 7, 100, 12345}) {
+    double S[9];
+    enumerated_power_sums<8>(N, S);
+
+    long double expected[9] = {};
+    for (size_t i = 0; i < N; i++) {
+      long double xx = 1;
+      for (int k = 0; k <= 8; k++) {
+        expected[k] += xx;
+        xx = xx * i;
+      }
+    }
+
+    for (int k = 0; k <= 8; k++) {
+      ASSERT_DOUBLE_EQ(S[k], expected[k]);
+    }
+  }
+}
+
 // Quadratic
 TEST(Fit, n2_single_vector_fixed) {
   // y = f(x) = ax^2 + bx + c
@@ -132,6 +196,75 @@ TEST(Fit, n2_single_vector_fixed) {
   ASSERT_FLOAT_EQ(p[2], a);
 }
 
+// Many threads fitting concurrently while the projection is being initialized
+TEST(Fit, n3_fixed_threads) {
+  std::vector<double> y;
+  for (int xx = 0; xx < 50; xx++) {
+    y.push_back(xx * xx * xx - 2 * xx * xx + 3 * xx + 4);
+  }
+
+  std::vector<Polynomial<3>> results(8);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&y, &results, t]() {
+      results[t] = polynomial_regression_fixed<3, 50>(y, true);
+    });
+  }
+  for (auto &thread: threads) {
+    thread.join();
+  }
+
+  auto expected = polynomial_regression<3>(y);
+  for (auto &p: results) {
+    ASSERT_NEAR(p[0], 4, 1E-6);
+    ASSERT_NEAR(p[1], 3, 1E-6);
+    ASSERT_NEAR(p[2], -2, 1E-6);
+    ASSERT_NEAR(p[3], 1, 1E-6);
+    ASSERT_NEAR(p.residual(), 0, 1E-6);
+    ASSERT_NEAR(p[1], expected[1], 1E-6);
+  }
+}
+
+// Weights of the fixed size fit are computed at compile time
+TEST(Fit, n2_fixed_constexpr) {
+  static_assert(is_constexpr_projection<2, 5, double>);
+  static constexpr FixedProjection<2, 5, double> projection;
+
+  // Value at the center of the window, these are well known Savitzky-Golay coefficients
+  constexpr double expected[5] = {-3.0 / 35, 12.0 / 35, 17.0 / 35, 12.0 / 35, -3.0 / 35};
+  for (int i = 0; i < 5; i++) {
+    constexpr double center = 2;
+    double w = projection.weight(i, 0) + projection.weight(i, 1) * center + projection.weight(i, 2) * center * center;
+    ASSERT_NEAR(w, expected[i], 1E-12);
+  }
+}
+
+// Multiple threads, reproducible regardless of the number of threads
+TEST(Fit, n3_parallel) {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  for (int i = 0; i < 300000; i++) {
+    double xx = i * 1E-5 - 1.5;
+    x.push_back(xx);
+    y.push_back(std::sin(xx));
+  }
+
+  auto expected = polynomial_regression<3>(x, y, true);
+  auto reproducible = polynomial_regression<3>(x, y, Parallel{1, true}, true);
+
+  for (unsigned threads: {2, 3, 8}) {
+    auto p = polynomial_regression<3>(x, y, Parallel{threads}, true);
+    auto r = polynomial_regression<3>(x, y, Parallel{threads, true}, true);
+    for (int k = 0; k <= 3; k++) {
+      ASSERT_NEAR(p[k], expected[k], 1E-9);
+      ASSERT_EQ(r[k], reproducible[k]);
+    }
+    ASSERT_NEAR(p.residual(), expected.residual(), 1E-9);
+    ASSERT_EQ(r.residual(), reproducible.residual());
+  }
+}
+
 // Quadratic
 TEST(Fit, n2_dequeue) {
   // y = f(x) = ax^2 + bx + c
@@ -278,4 +411,84 @@ TEST(Fit, n4_double) {
   ASSERT_FLOAT_EQ(p[2], c);
   ASSERT_FLOAT_EQ(p[3], b);
   ASSERT_FLOAT_EQ(p[4], a);
-}
\ No newline at end of file
+}
+
+TEST(Fit, low_order_far_from_zero) {
+  // Centered sums keep the straight line exact even if X is far from zero
+  std::deque<double> x;
+  std::deque<double> y;
+  std::vector<double> xv;
+  std::vector<double> yv;
+  for (int i = 0; i < 1000; i++) {
+    double xx = 1E6 + i;
+    x.push_back(xx);
+    y.push_back(3 - 0.5 * xx + (i % 4 == 0 || i % 4 == 3 ? 0.25 : -0.25));
+    xv.push_back(x.back());
+    yv.push_back(y.back());
+  }
+
+  Polynomial<1> line = polynomial_regression<1>(x, y, true);
+  ASSERT_NEAR(line[1], -0.5, 1E-9);
+  ASSERT_NEAR(line[0], 3, 1E-3);
+  ASSERT_NEAR(line.residual(), 1000 * 0.0625, 1E-6);
+
+  Polynomial<0> constant = polynomial_regression<0>(x, y);
+  ASSERT_NEAR(constant[0], 3 - 0.5 * (1E6 + 499.5), 1E-6);
+
+  // Contiguous data uses the vectorized sums of the shifted points, and must be as precise
+  Polynomial<1> line_vector = polynomial_regression<1>(xv, yv, true);
+  ASSERT_NEAR(line_vector[1], -0.5, 1E-9);
+  ASSERT_NEAR(line_vector[0], 3, 1E-3);
+  ASSERT_NEAR(line_vector.residual(), 1000 * 0.0625, 1E-6);
+
+  Polynomial<1> line_parallel = polynomial_regression<1>(xv, yv, Parallel{4});
+  ASSERT_NEAR(line_parallel[1], -0.5, 1E-9);
+
+  Polynomial<2> parabola = polynomial_regression<2>(xv, yv);
+  ASSERT_NEAR(parabola[2], 0, 1E-9);
+  ASSERT_NEAR(parabola(1E6 + 500), 3 - 0.5 * (1E6 + 500), 1E-2);
+
+  Polynomial<2> parabola_deque = polynomial_regression<2>(x, y);
+  ASSERT_NEAR(parabola_deque[2], 0, 1E-9);
+}
+
+TEST(Fit, line_very_far_from_zero) {
+  // Same result for any container, even where the raw sums of x^2 lose all digits of the spread
+  std::vector<double> xv;
+  std::vector<double> yv;
+  for (int i = 0; i < 1000; i++) {
+    xv.push_back(1E8 + i);
+    yv.push_back(3 - 0.5 * i);
+  }
+  std::deque<double> x(xv.begin(), xv.end());
+  std::deque<double> y(yv.begin(), yv.end());
+
+  ASSERT_NEAR(polynomial_regression<1>(xv, yv)[1], -0.5, 1E-9);
+  ASSERT_NEAR(polynomial_regression<1>(x, y)[1], -0.5, 1E-9);
+  ASSERT_NEAR(polynomial_regression<2>(xv, yv)[1], -0.5, 1E-6);
+  ASSERT_NEAR((polynomial_regression<2>(xv, yv)(1E8 + 10)), -2, 1E-6);
+}
+
+TEST(Fit, residual_only_if_asked) {
+  // Every overload taking compute_residual leaves the residual NaN unless asked, and computes the same value if asked
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 100; i++) {
+    x.push_back(i);
+    y.push_back(0.1 * i * i - 2 * i + (i % 2 == 0 ? 0.5 : -0.5));
+  }
+
+  ASSERT_TRUE(std::isnan(polynomial_regression<2>(x, y).residual()));
+  ASSERT_TRUE(std::isnan(polynomial_regression<2>(x, y, Parallel{2}).residual()));
+  ASSERT_TRUE(std::isnan(polynomial_regression<2>(y).residual()));
+  ASSERT_TRUE(std::isnan((polynomial_regression_fixed<2, 100>(y).residual())));
+  ASSERT_TRUE(std::isnan(polynomial_regression_dynamic(2, x, y).residual()));
+  ASSERT_TRUE(std::isnan(polynomial_regression<1>(std::deque<double>(x.begin(), x.end()), y).residual()));
+
+  double expected = polynomial_regression<2>(x, y, true).residual();
+  ASSERT_NEAR(expected, 25, 0.1);
+  ASSERT_NEAR(polynomial_regression<2>(x, y, Parallel{2}, true).residual(), expected, 1E-6);
+  ASSERT_NEAR(polynomial_regression<2>(y, true).residual(), expected, 1E-6);
+  ASSERT_NEAR((polynomial_regression_fixed<2, 100>(y, true).residual()), expected, 1E-6);
+  ASSERT_NEAR(polynomial_regression_dynamic(2, x, y, true).residual(), expected, 1E-6);
+}
@@ -1,3 +1,5 @@
+#include <deque>
+#include <iterator>
 #include "gtest/gtest.h"
 
 #include "polynomial_regression.hpp"
@@ -73,6 +75,41 @@ TEST(Interpolate, n2_int) {
   }
 }
 
+// Many points at once, must match evaluating one by one
+TEST(Interpolate, n3_batch) {
+  Polynomial<3> polynomial({1.5, -2, 0.25, 0.125});
+
+  std::vector<double> x;
+  for (int i = 0; i < 1000; i++) {
+    x.push_back(i * 0.01 - 5);
+  }
+
+  std::vector<double> values(x.size());
+  polynomial.evaluate(x.data(), values.data(), x.size());
+
+  std::deque<double> from_iterators;
+  polynomial.evaluate_iter(x.cbegin(), x.cend(), std::back_inserter(from_iterators));
+  ASSERT_EQ(from_iterators.size(), x.size());
+
+  for (int i = 0; i < x.size(); i++) {
+    ASSERT_DOUBLE_EQ(values[i], polynomial(x[i]));
+    ASSERT_DOUBLE_EQ(from_iterators[i], values[i]);
+  }
+}
+
+// Batch evaluation must also round for integral types
+TEST(Interpolate, n2_batch_int) {
+  Polynomial<2, uint8_t, double> polynomial({4.4, 3, 2});
+
+  std::vector<uint8_t> x = {0, 1, 2, 3, 4, 5};
+  std::vector<uint8_t> values(x.size());
+  polynomial.evaluate(x.data(), values.data(), x.size());
+
+  for (int i = 0; i < x.size(); i++) {
+    ASSERT_EQ(values[i], polynomial(x[i]));
+  }
+}
+
 // High degree
 TEST(Interpolate, n8_float) {
   constexpr int degree = 8;
@@ -102,6 +139,47 @@ TEST(Interpolate, n8_float) {
   }
 }
 
+// High degree in plain double with the stable solver
+TEST(Interpolate, n20_stable_double) {
+  constexpr int degree = 20;
+
+  std::vector<double> x;
+  std::vector<double> y;
+
+  // Interpolating sin(x)
+  for (double xx = -M_PI; xx < M_PI; xx = xx + 0.001) {
+    x.push_back(xx);
+    y.push_back(std::sin(xx));
+  }
+
+  Polynomial<degree> polynomial = polynomial_regression_stable<degree>(x, y, true);
+
+  for (int i = 0; i < x.size(); i++) {
+    ASSERT_NEAR(polynomial(x[i]), y[i], 1E-10);
+  }
+  ASSERT_NEAR(polynomial.residual(), 0, 1E-15);
+  ASSERT_NEAR(polynomial.r_squared(), 1, 1E-12);
+}
+
+// Shifted and scaled X, comparing with the normal equations at low degree
+TEST(Interpolate, n3_stable_shifted) {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  for (int i = 0; i < 50; i++) {
+    double xx = 3 + i * 0.1;
+    x.push_back(xx);
+    y.push_back(0.5 * xx * xx * xx - 2 * xx * xx + xx - 7 + std::sin(i));
+  }
+
+  auto stable = polynomial_regression_stable<3>(x, y, true);
+  auto expected = polynomial_regression<3>(x, y, true);
+  for (int k = 0; k <= 3; k++) {
+    ASSERT_NEAR(stable[k], expected[k], 1E-8);
+  }
+  ASSERT_NEAR(stable.residual(), expected.residual(), 1E-8);
+}
+
 // Using 128 bit float if such available
 #ifdef  __SIZEOF_FLOAT128__
 TEST(Interpolate, n64_float128) {
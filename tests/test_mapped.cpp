@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <string>
+#include "gtest/gtest.h"
+
+#include "MappedColumn.hpp"
+
+using namespace andviane;
+
+namespace {
+  template<typename T>
+  std::string write_column(const std::string &name, const std::vector<T> &values) {
+    std::string path = testing::TempDir() + name;
+    FILE *file = fopen(path.c_str(), "wb");
+    fwrite(values.data(), sizeof(T), values.size(), file);
+    fclose(file);
+    return path;
+  }
+}
+
+// Mapped columns of different types give the same fit as vectors
+TEST(Mapped, columns) {
+  std::vector<double> x;
+  std::vector<float> y;
+  std::vector<uint8_t> y8;
+  for (int i = 0; i < 1000; i++) {
+    x.push_back(i * 0.01);
+    y.push_back((float) (1 + 2 * x.back() - 0.5 * x.back() * x.back()));
+    y8.push_back((uint8_t) (i % 7));
+  }
+
+  MappedColumn x_column;
+  MappedColumn y_column;
+  MappedColumn y8_column;
+  ASSERT_TRUE(x_column.open(write_column("mapped_x.f64", x), ColumnType::FLOAT64));
+  ASSERT_TRUE(y_column.open(write_column("mapped_y.f32", y), ColumnType::FLOAT32));
+  ASSERT_TRUE(y8_column.open(write_column("mapped_y.u8", y8), ColumnType::UINT8));
+  ASSERT_EQ(x_column.size(), 1000);
+  ASSERT_EQ(y8_column.size(), 1000);
+
+  auto p = polynomial_regression_mapped<2>(x_column, y_column);
+  auto expected = polynomial_regression<2>(x, y);
+  for (int k = 0; k <= 2; k++) {
+    ASSERT_NEAR(p[k], expected[k], 1E-9);
+  }
+
+  // Row range, X enumerating from 0
+  auto range = polynomial_regression_mapped<1>(y8_column, 100, 350);
+  std::vector<uint8_t> part(y8.begin() + 100, y8.begin() + 450);
+  auto expected_range = polynomial_regression<1, double>(part);
+  ASSERT_EQ(range.data_size(), 350);
+  ASSERT_NEAR(range[0], expected_range[0], 1E-9);
+  ASSERT_NEAR(range[1], expected_range[1], 1E-9);
+
+  // The count is limited by the end of the column
+  ASSERT_EQ(polynomial_regression_mapped<1>(x_column, y_column, 900).data_size(), 100);
+}
+
+// Timestamp columns far from zero keep the precision of the slope
+TEST(Mapped, timestamps) {
+  std::vector<double> t;
+  std::vector<double> y;
+  for (int i = 0; i < 1000; i++) {
+    t.push_back(1.7E9 + i);
+    y.push_back(3 - 0.5 * i);
+  }
+
+  MappedColumn t_column;
+  MappedColumn y_column;
+  ASSERT_TRUE(t_column.open(write_column("mapped_t.f64", t), ColumnType::FLOAT64));
+  ASSERT_TRUE(y_column.open(write_column("mapped_ty.f64", y), ColumnType::FLOAT64));
+
+  auto line = polynomial_regression_mapped<1>(t_column, y_column);
+  ASSERT_NEAR(line[1], -0.5, 1E-9);
+  ASSERT_NEAR(line(1.7E9 + 10), -2, 1E-6);
+  ASSERT_NEAR(line.residual(), 0, 1E-9);
+
+  auto parabola = polynomial_regression_mapped<2>(t_column, y_column, 200, 500);
+  ASSERT_EQ(parabola.data_size(), 500);
+  ASSERT_NEAR(parabola[1], -0.5, 1E-6);
+}
+
+// Files of wrong size or missing files are not opened
+TEST(Mapped, errors) {
+  MappedColumn column;
+  ASSERT_FALSE(column.open(testing::TempDir() + "mapped_missing", ColumnType::FLOAT64));
+  std::vector<uint8_t> bytes(13);
+  ASSERT_FALSE(column.open(write_column("mapped_odd", bytes), ColumnType::FLOAT32));
+  ASSERT_EQ(column.size(), 0);
+}
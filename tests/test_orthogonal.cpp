@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Fits of every degree must match separate fits of that degree
+TEST(Orthogonal, all_degrees) {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  for (int i = 0; i < 200; i++) {
+    double xx = i * 0.05 - 4;
+    x.push_back(xx);
+    y.push_back(std::atan(xx) + 0.1 * std::sin(7 * xx));
+  }
+
+  auto all = polynomial_regression_all<5>(x, y);
+  ASSERT_EQ(all.data_size(), 200);
+
+  auto p1 = polynomial_regression<1>(x, y, true);
+  auto q1 = all.polynomial<1>();
+  ASSERT_NEAR(q1[0], p1[0], 1E-10);
+  ASSERT_NEAR(q1[1], p1[1], 1E-10);
+  ASSERT_NEAR(all.residual(1), p1.residual(), 1E-9);
+
+  auto p3 = polynomial_regression<3>(x, y, true);
+  auto q3 = all.polynomial(3);
+  for (int k = 0; k <= 3; k++) {
+    ASSERT_NEAR(q3[k], p3[k], 1E-10);
+  }
+  ASSERT_EQ(q3[4], 0);
+  ASSERT_EQ(q3[5], 0);
+  ASSERT_NEAR(q3.residual(), p3.residual(), 1E-9);
+  ASSERT_NEAR(q3.r_squared(), p3.r_squared(), 1E-12);
+
+  // Residual never grows with the degree
+  for (int degree = 1; degree <= 5; degree++) {
+    ASSERT_LE(all.residual(degree), all.residual(degree - 1) + 1E-12);
+  }
+}
+
+// The degree of the underlying polynomial with some noise must be found
+TEST(Orthogonal, select_degree) {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  for (int i = 0; i < 500; i++) {
+    double xx = i * 0.01 - 2.5;
+    x.push_back(xx);
+    // Deterministic noise
+    y.push_back(xx * xx * xx - 2 * xx + 1 + 0.01 * std::sin(i * 12.9898));
+  }
+
+  auto all = polynomial_regression_all<8>(x, y);
+  ASSERT_EQ(all.select_degree(DegreeCriterion::BIC), 3);
+  ASSERT_EQ(all.select_degree(0.01), 3);
+
+  int aic = all.select_degree(DegreeCriterion::AIC);
+  ASSERT_GE(aic, 3);
+}
@@ -0,0 +1,141 @@
+#include <cmath>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Function made of two parabolas meeting at x = 5
+static double two_parabolas(double x) {
+  return x < 5 ? 1 + 2 * x - 0.5 * x * x : -1 + 0.3 * (x - 5) + 2 * (x - 5) * (x - 5);
+}
+
+// Segments over the exact pieces recover them, in the local coordinate
+TEST(Piecewise, fixed_knots) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i <= 1000; i++) {
+    x.push_back(i * 0.01);
+    y.push_back(two_parabolas(x.back()));
+  }
+
+  PiecewisePolynomial<2> p = polynomial_regression_piecewise<2>(x, y, std::vector<double>{0.0, 5.0, 10.0});
+  ASSERT_EQ(p.segments(), 2);
+  ASSERT_EQ(p.data_size(), 1001);
+  ASSERT_NEAR(p.residual(), 0, 1E-9);
+  ASSERT_NEAR(p.coefficients(1)[0], -1, 1E-9);
+  ASSERT_NEAR(p.coefficients(1)[1], 0.3, 1E-9);
+  ASSERT_NEAR(p.coefficients(1)[2], 2, 1E-9);
+  for (double v: {0.0, 1.234, 4.99, 5.0, 7.5, 10.0})
+    ASSERT_NEAR(p(v), two_parabolas(v), 1E-9);
+
+  // Equal width segments split the same way, with any number of threads
+  PiecewisePolynomial<2> q = polynomial_regression_piecewise<2>(x, y, (size_t) 2, {1});
+  ASSERT_NEAR(q.residual(), 0, 1E-9);
+  ASSERT_NEAR(q(8.0), two_parabolas(8.0), 1E-9);
+}
+
+// Adaptive splitting reaches the tolerance on a function no single polynomial fits
+TEST(Piecewise, adaptive) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 4096; i++) {
+    x.push_back(i * 0.005);
+    y.push_back(std::sin(x.back()));
+  }
+
+  double tolerance = 1E-8;
+  PiecewisePolynomial<2> p = polynomial_regression_piecewise_adaptive<2>(x, y, tolerance, 16);
+  ASSERT_GT(p.segments(), 1);
+  ASSERT_EQ(p.data_size(), 4096);
+  ASSERT_LE(p.residual(), tolerance * 4096);
+  for (size_t s = 0; s + 1 < p.segments(); s++)
+    ASSERT_LT(p.knot(s), p.knot(s + 1));
+  for (int i = 0; i < 4096; i += 37)
+    ASSERT_NEAR(p(x[i]), y[i], 1E-3);
+
+  // Never split below the minimal size
+  PiecewisePolynomial<2> coarse = polynomial_regression_piecewise_adaptive<2>(x, y, 0.0, 1024);
+  ASSERT_EQ(coarse.segments(), 4);
+}
+
+// Continuous fit has no jumps at the knots, and still follows the data
+TEST(Piecewise, continuous) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 2000; i++) {
+    x.push_back(i * 0.01);
+    y.push_back(std::cos(x.back()) + (i % 2 == 0 ? 0.01 : -0.01));
+  }
+
+  PiecewiseOptions options;
+  options.continuous = true;
+  PiecewisePolynomial<3> p = polynomial_regression_piecewise<3>(x, y, (size_t) 14, options);
+  ASSERT_EQ(p.segments(), 14);
+  for (size_t s = 1; s < p.segments(); s++) {
+    double knot = p.knot(s);
+    const double *previous = p.coefficients(s - 1);
+    double u = knot - p.knot(s - 1);
+    double left = previous[0] + u * (previous[1] + u * (previous[2] + u * previous[3]));
+    ASSERT_NEAR(p.coefficients(s)[0], left, 1E-12);
+  }
+  for (int i = 0; i < 2000; i += 13)
+    ASSERT_NEAR(p(x[i]), std::cos(x[i]), 0.02);
+
+  // Constrained fit cannot be better than the free one
+  PiecewisePolynomial<3> free = polynomial_regression_piecewise<3>(x, y, (size_t) 14);
+  ASSERT_GE(p.residual(), free.residual() - 1E-12);
+}
+
+// Segment lookup with unevenly spaced knots, and batch evaluation agreeing with the single point one
+TEST(Piecewise, lookup) {
+  std::vector<double> knots = {0, 0.1, 0.15, 2, 2.5, 7, 7.01, 10};
+  std::vector<double> coefficients;
+  for (size_t s = 0; s + 1 < knots.size(); s++) {
+    coefficients.push_back(s);
+    coefficients.push_back(1);
+  }
+  PiecewisePolynomial<1> p(knots, coefficients);
+  ASSERT_EQ(p.segments(), 7);
+  ASSERT_EQ(p.segment_of(-1), 0);
+  ASSERT_EQ(p.segment_of(0.12), 1);
+  ASSERT_EQ(p.segment_of(0.15), 2);
+  ASSERT_EQ(p.segment_of(7.005), 5);
+  ASSERT_EQ(p.segment_of(7.01), 6);
+  ASSERT_EQ(p.segment_of(11), 6);
+
+  std::vector<double> xs;
+  for (int i = 0; i < 1000; i++)
+    xs.push_back(i * 0.0111 - 0.5);
+  std::vector<double> out(xs.size());
+  p.evaluate(xs.data(), out.data(), xs.size());
+  for (size_t i = 0; i < xs.size(); i++) {
+    size_t s = std::upper_bound(knots.begin() + 1, knots.end() - 1, xs[i]) - knots.begin() - 1;
+    ASSERT_EQ(p.segment_of(xs[i]), s);
+    ASSERT_EQ(out[i], p(xs[i]));
+  }
+}
+
+// Equally spaced knots find the segment directly, every cell holds one segment
+TEST(Piecewise, uniform_lookup) {
+  std::vector<double> knots;
+  std::vector<double> coefficients;
+  for (int s = 0; s <= 16; s++)
+    knots.push_back(s * 0.5);
+  for (int s = 0; s < 16; s++) {
+    coefficients.push_back(s);
+    coefficients.push_back(0);
+  }
+  PiecewisePolynomial<1> p(knots, coefficients);
+  ASSERT_EQ(p.ambiguous_cells(), 0);
+  for (int i = 0; i < 800; i++) {
+    double x = i * 0.01;
+    ASSERT_EQ(p.segment_of(x), (size_t) (x / 0.5));
+    ASSERT_EQ(p(x), (int) (x / 0.5));
+  }
+
+  // Uneven knots still give correct segments through the binary search
+  PiecewisePolynomial<1> uneven({0, 0.1, 0.15, 2}, {0, 0, 1, 0, 2, 0});
+  ASSERT_GT(uneven.ambiguous_cells(), 0);
+  ASSERT_EQ(uneven.segment_of(0.12), 1);
+}
@@ -0,0 +1,86 @@
+#include <cmath>
+#include <deque>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Value of the d-th derivative at x from fitting the window of samples starting at y, spacing 1
+template<int n, int window>
+static double fitted(const double *y, int d, double x) {
+  std::vector<double> w(y, y + window);
+  Polynomial<n> p = polynomial_regression_fixed<n, window>(w);
+  if (d == 0)
+    return p(x);
+  if (d == 1)
+    return p.differentiate()(x);
+  return p.differentiate().differentiate()(x);
+}
+
+// The filter matches the fit per sample, including the edges
+TEST(SavitzkyGolay, matches_fit) {
+  constexpr int window = 11;
+  std::vector<double> y;
+  for (int i = 0; i < 1200; i++)
+    y.push_back(std::sin(i * 0.05) * 10 + (i % 3 == 0 ? 0.5 : -0.25));
+
+  for (int d = 0; d <= 2; d++) {
+    SavitzkyGolayFilter<3, window> filter(d);
+    std::vector<double> out = filter.apply(y);
+    ASSERT_EQ(out.size(), y.size());
+    for (int j = 0; j < (int) y.size(); j++) {
+      int start = std::min(std::max(j - window / 2, 0), (int) y.size() - window);
+      ASSERT_NEAR(out[j], (fitted<3, window>(y.data() + start, d, j - start)), 1E-9) << d << " " << j;
+    }
+  }
+}
+
+// Polynomials up to the order of the filter pass unchanged, derivatives scale with the spacing
+TEST(SavitzkyGolay, polynomial_signal) {
+  double h = 0.01;
+  std::vector<float> y;
+  for (int i = 0; i < 5000; i++) {
+    double x = i * h;
+    y.push_back((float) (1 + 2 * x - 0.5 * x * x));
+  }
+
+  SavitzkyGolayFilter<2, 31, float, double> smooth;
+  std::vector<float> out(y.size());
+  smooth.apply(y.data(), out.data(), y.size());
+  for (size_t i = 0; i < y.size(); i++)
+    ASSERT_NEAR(out[i], y[i], 1E-3);
+
+  SavitzkyGolayFilter<2, 31, float, double> slope(1, h);
+  ASSERT_EQ(slope.derivative(), 1);
+  std::vector<float> dy = slope.apply(y);
+  for (size_t i = 0; i < y.size(); i++)
+    ASSERT_NEAR(dy[i], 2 - i * h, 1E-3);
+
+  // Kernel of the value in the middle sums to one, the kernel of the derivative to zero
+  double sum = 0;
+  double sum_slope = 0;
+  for (int i = 0; i < 31; i++) {
+    sum += smooth.kernel(15)[i];
+    sum_slope += slope.kernel(15)[i];
+  }
+  ASSERT_NEAR(sum, 1, 1E-12);
+  ASSERT_NEAR(sum_slope, 0, 1E-9);
+}
+
+// Collections that are not contiguous, or hold another type, give the same result
+TEST(SavitzkyGolay, collections) {
+  std::vector<double> y;
+  for (int i = 0; i < 300; i++)
+    y.push_back(std::cos(i * 0.1) + (i % 2 == 0 ? 0.1 : -0.1));
+
+  SavitzkyGolayFilter<2, 9> filter(1);
+  std::vector<double> expected = filter.apply(y);
+  std::vector<double> from_deque = filter.apply(std::deque<double>(y.begin(), y.end()));
+  ASSERT_EQ(from_deque, expected);
+
+  std::vector<float> yf(y.begin(), y.end());
+  std::vector<double> from_float = filter.apply(yf);
+  for (size_t i = 0; i < y.size(); i++)
+    ASSERT_NEAR(from_float[i], expected[i], 1E-6);
+}
@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Compare the sliding window with the full fit over the same points
+TEST(SlidingWindow, n2) {
+  constexpr int window = 16;
+  SlidingWindowRegression<2> sliding(window);
+
+  std::vector<double> x;
+  std::vector<double> y;
+
+  for (int i = 0; i < 100; i++) {
+    double xx = i * 0.25;
+    double yy = std::sin(xx) * 10;
+    x.push_back(xx);
+    y.push_back(yy);
+    sliding.add(xx, yy);
+
+    if (i >= window) {
+      ASSERT_EQ(sliding.size(), window);
+      std::vector<double> wx(x.end() - window, x.end());
+      std::vector<double> wy(y.end() - window, y.end());
+
+      auto expected = polynomial_regression<2>(wx, wy);
+      auto p = sliding.solve();
+      for (int k = 0; k <= 2; k++) {
+        ASSERT_NEAR(p[k], expected[k], 1E-6);
+      }
+    }
+  }
+}
+
+// X enumerated inside the window
+TEST(SlidingWindow, n2_enumerated) {
+  constexpr int window = 10;
+  SlidingWindowRegression<2> sliding(window);
+
+  std::vector<double> y;
+
+  for (int i = 0; i < 100; i++) {
+    double yy = std::cos(i * 0.1) * 10;
+    y.push_back(yy);
+    sliding.add(yy);
+
+    if (i >= window) {
+      std::vector<double> wy(y.end() - window, y.end());
+
+      auto expected = polynomial_regression<2>(wy);
+      auto p = sliding.solve();
+      for (int k = 0; k <= 2; k++) {
+        ASSERT_NEAR(p[k], expected[k], 1E-8);
+      }
+    }
+  }
+
+  sliding.rebuild();
+  std::vector<double> wy(y.end() - window, y.end());
+  auto expected = polynomial_regression<2>(wy);
+  auto p = sliding.solve();
+  for (int k = 0; k <= 2; k++) {
+    ASSERT_FLOAT_EQ(p[k], expected[k]);
+  }
+}
+
+// Long stream with X enumerated stays as precise as the fresh fit
+TEST(SlidingWindow, long_stream_enumerated) {
+  constexpr int window = 50;
+  SlidingWindowRegression<3> sliding(window);
+  std::vector<double> ring(window);
+
+  for (int i = 0; i < 1000000; i++) {
+    double yy = 1000 + std::sin(i * 0.001) * 100 + (i % 7) * 0.5;
+    ring[i % window] = yy;
+    sliding.add(yy);
+
+    if (i % 250000 == 249999 || i == 999999) {
+      std::vector<double> wy;
+      for (int k = 0; k < window; k++)
+        wy.push_back(ring[(i + 1 + k) % window]);
+      auto expected = polynomial_regression<3>(wy, true);
+      auto p = sliding.solve();
+      for (int k = 0; k <= 3; k++) {
+        ASSERT_NEAR(p[k], expected[k], 1E-9 * std::pow(window, -k) * 1000) << i << " " << k;
+      }
+      ASSERT_NEAR(p.residual(), expected.residual(), 1E-6);
+    }
+  }
+}
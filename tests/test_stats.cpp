@@ -0,0 +1,82 @@
+#include <deque>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Fit with statistics must give the same result, and statistics must add up over fits
+TEST(Stats, aggregate) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 1000; i++) {
+    double xx = i * 0.002 - 1;
+    x.push_back(xx);
+    y.push_back(1 + 2 * xx - 3 * xx * xx);
+  }
+
+  FitStats stats;
+  auto p = polynomial_regression<2>(x, y, stats);
+  auto expected = polynomial_regression<2>(x, y, true);
+  for (int k = 0; k <= 2; k++) {
+    ASSERT_EQ(p[k], expected[k]);
+  }
+  ASSERT_EQ(p.residual(), expected.residual());
+
+  ASSERT_EQ(stats.fits, 1);
+  ASSERT_EQ(stats.data_points, 1000);
+  ASSERT_GT(stats.min_pivot, 0);
+  ASSERT_GE(stats.last_condition, 1);
+  ASSERT_EQ(stats.max_condition, stats.last_condition);
+  ASSERT_EQ(stats.bytes_allocated, 0);
+
+  // Y only, X in 0 .. 999 is much worse conditioned than X in [-1, 1]
+  std::deque<double> yd(y.begin(), y.end());
+  FitStats enumerated;
+  polynomial_regression<2>(yd, enumerated);
+  ASSERT_GT(enumerated.last_condition, stats.last_condition * 1000);
+
+  FitStats total;
+  total += stats;
+  total += enumerated;
+  ASSERT_EQ(total.fits, 2);
+  ASSERT_EQ(total.data_points, 2000);
+  ASSERT_EQ(total.max_condition, enumerated.last_condition);
+  ASSERT_EQ(total.min_pivot, std::min(stats.min_pivot, enumerated.min_pivot));
+  ASSERT_EQ(total.accumulation, stats.accumulation + enumerated.accumulation);
+}
+
+// Condition number of a small system can be checked by hand
+TEST(Stats, condition) {
+  // X = {1, 0, 2} is shifted by the first point to {0, -1, 1}: G = [[3, 0], [0, 2]], condition 3 * 0.5
+  std::vector<double> x = {1, 0, 2};
+  std::vector<double> y = {2, 1, 3};
+  FitStats stats;
+  auto p = polynomial_regression<1>(x, y, stats);
+  ASSERT_NEAR(p[0], 1, 1E-12);
+  ASSERT_NEAR(p[1], 1, 1E-12);
+  ASSERT_NEAR(stats.last_condition, 1.5, 1E-12);
+  ASSERT_EQ(stats.min_pivot, 2);
+  ASSERT_EQ(stats.pivot_swaps, 0);
+}
+
+// Dynamic regression reports heap memory for high orders
+TEST(Stats, dynamic) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 100; i++) {
+    x.push_back(i * 0.02 - 1);
+    y.push_back(std::sin(x.back()));
+  }
+
+  FitStats stats;
+  auto p = polynomial_regression_dynamic(3, x, y, stats);
+  auto expected = polynomial_regression_dynamic(3, x, y);
+  ASSERT_EQ(p[3], expected[3]);
+  ASSERT_EQ(stats.bytes_allocated, 0);
+
+  polynomial_regression_dynamic<double, long double>(20, x, y, stats);
+  ASSERT_EQ(stats.fits, 2);
+  ASSERT_GT(stats.bytes_allocated, 0);
+  ASSERT_GT(stats.max_condition, 1E10);
+}
@@ -0,0 +1,65 @@
+#include <deque>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Exact surface is recovered, with zero residual
+TEST(Surface, fit) {
+  std::vector<double> x;
+  std::vector<double> y;
+  std::deque<double> z;
+  for (int i = 0; i < 40; i++)
+    for (int j = 0; j < 30; j++) {
+      double xx = i * 0.05 - 1;
+      double yy = j * 0.07 - 1;
+      x.push_back(xx);
+      y.push_back(yy);
+      z.push_back(1 + 2 * xx - 3 * yy + 0.5 * xx * yy - xx * xx + 4 * yy * yy);
+    }
+
+  Polynomial2D<2> p = polynomial_regression_2d<2>(x, y, z);
+  ASSERT_EQ(p.data_size(), 1200);
+  ASSERT_NEAR(p.coefficient(0, 0), 1, 1E-10);
+  ASSERT_NEAR(p.coefficient(1, 0), 2, 1E-10);
+  ASSERT_NEAR(p.coefficient(0, 1), -3, 1E-10);
+  ASSERT_NEAR(p.coefficient(1, 1), 0.5, 1E-10);
+  ASSERT_NEAR(p.coefficient(2, 0), -1, 1E-10);
+  ASSERT_NEAR(p.coefficient(0, 2), 4, 1E-10);
+  ASSERT_NEAR(p.residual(), 0, 1E-9);
+  ASSERT_NEAR(p.r_squared(), 1, 1E-12);
+  ASSERT_NEAR(p(0.5, -0.5), 1 + 1 + 1.5 - 0.125 - 0.25 + 1, 1E-10);
+
+  // Higher degree keeps the surface, the extra coefficients are zero
+  Polynomial2D<3> p3 = polynomial_regression_2d<3>(x, y, z);
+  ASSERT_NEAR(p3.coefficient(2, 1), 0, 1E-8);
+  ASSERT_NEAR(p3.coefficient(1, 1), 0.5, 1E-8);
+}
+
+// Batch and grid evaluation agree with the single point one
+TEST(Surface, evaluate) {
+  Polynomial2D<3> p;
+  for (int k = 0; k < Polynomial2D<3>::terms; k++)
+    p[k] = 0.5 * k - 2;
+
+  std::vector<double> xs;
+  std::vector<double> ys;
+  for (int i = 0; i < 300; i++) {
+    xs.push_back(i * 0.01 - 1);
+    ys.push_back(1 - i * 0.005);
+  }
+
+  std::vector<double> values(300);
+  p.evaluate(xs.data(), ys.data(), values.data(), 300);
+  for (int i = 0; i < 300; i++) {
+    ASSERT_NEAR(values[i], p(xs[i], ys[i]), 1E-12);
+  }
+
+  std::vector<double> grid(300 * 20);
+  p.evaluate_grid(xs.data(), 300, ys.data(), 20, grid.data());
+  for (int r = 0; r < 20; r++)
+    for (int c = 0; c < 300; c += 7) {
+      ASSERT_NEAR(grid[r * 300 + c], p(xs[c], ys[r]), 1E-12);
+    }
+}
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "gtest/gtest.h"
+
+#include "polynomial_regression.hpp"
+
+using namespace andviane;
+
+// Count all heap allocations of the test binary.
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations++;
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+  std::free(p);
+}
+
+// After the first fit, fits of the same or lower order with the workspace must not allocate
+TEST(Workspace, dynamic_no_allocations) {
+  std::vector<double> x;
+  std::vector<double> y;
+  for (int i = 0; i < 500; i++) {
+    double xx = i * 0.004 - 1;
+    x.push_back(xx);
+    y.push_back(std::cos(3 * xx));
+  }
+
+  RegressionWorkspace<double> workspace;
+  DynamicPolynomial<double> result;
+
+  // Order above the inline capacity of DynamicPolynomial, so that its storage is also on the heap.
+  polynomial_regression_dynamic(20, x, y, workspace, result);
+  auto expected = polynomial_regression_dynamic(6, x, y, true);
+
+  size_t before = allocations;
+  for (int order = 20; order >= 0; order--) {
+    polynomial_regression_dynamic(order, x, y, workspace, result);
+  }
+  polynomial_regression_dynamic(6, x, y, workspace, result);
+  ASSERT_TRUE(std::isnan(result.residual()));
+  polynomial_regression_dynamic(6, x, y, workspace, result, true);
+  ASSERT_EQ(allocations - before, 0);
+
+  ASSERT_EQ(result.order(), 6);
+  for (int k = 0; k <= 6; k++) {
+    ASSERT_EQ(result[k], expected[k]);
+  }
+  ASSERT_EQ(result.residual(), expected.residual());
+}
+
+// Batch regression with the workspace and preallocated results must not allocate
+TEST(Workspace, batch_no_allocations) {
+  const size_t N = 100;
+  const size_t series = 8;
+  std::vector<double> x(N);
+  std::vector<double> y(N * series);
+  for (size_t i = 0; i < N; i++) {
+    x[i] = i * 0.01;
+    for (size_t s = 0; s < series; s++) {
+      y[i * series + s] = s + x[i] * s - x[i] * x[i];
+    }
+  }
+
+  std::pmr::monotonic_buffer_resource resource;
+  RegressionWorkspace<double> workspace(&resource);
+  workspace.reserve(2, series);
+  std::vector<Polynomial<2>> out(series);
+
+  size_t before = allocations;
+  for (int repeat = 0; repeat < 10; repeat++) {
+    polynomial_regression_batch_iter<2>(x.data(), y.data(), N, series, workspace, out.data(),
+                                        Layout::ROW_MAJOR, true);
+  }
+  ASSERT_EQ(allocations - before, 0);
+
+  auto expected = polynomial_regression_batch_iter<2>(x.data(), y.data(), N, series, Layout::ROW_MAJOR, true);
+  for (size_t s = 0; s < series; s++) {
+    ASSERT_NEAR(out[s][0], s, 1E-9);
+    ASSERT_NEAR(out[s][1], s, 1E-9);
+    ASSERT_NEAR(out[s][2], -1, 1E-9);
+    ASSERT_EQ(out[s][1], expected[s][1]);
+    ASSERT_EQ(out[s].residual(), expected[s].residual());
+  }
+}